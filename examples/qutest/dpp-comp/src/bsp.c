@@ -46,9 +46,9 @@ enum {
 };
 
 //............................................................................
-void BSP_init(void) {
+void BSP_init(void const * const arg) {
     // initialize the QS software tracing
-    if (!QS_INIT((void *)0)) {
+    if (!QS_INIT(arg)) {
         Q_ERROR();
     }
 
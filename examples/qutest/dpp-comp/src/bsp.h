@@ -36,7 +36,7 @@
 
 #define BSP_TICKS_PER_SEC    100U
 
-void BSP_init(void);
+void BSP_init(void const * const arg);
 void BSP_start(void);
 void BSP_displayPaused(uint8_t paused);
 void BSP_displayPhilStat(uint8_t n, char const *stat);
@@ -46,9 +46,9 @@ QActive * const AO_Table = &Table_dummy.super;
 extern QAsm * const SM_Philo[N_PHILO];
 
 //............................................................................
-int main() {
+int main(int argc, char *argv[]) {
     QF_init();       // initialize the framework and the underlying RT kernel
-    BSP_init();      // initialize the BSP
+    BSP_init((argc > 1) ? argv[1] : (void *)0); // initialize the BSP
 
     // object dictionaries...
     QS_OBJ_DICTIONARY(&Table_dummy);
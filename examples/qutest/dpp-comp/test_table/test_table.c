@@ -55,9 +55,9 @@ void Philo_ctor(uint8_t n) {
 }
 
 //............................................................................
-int main() {
+int main(int argc, char *argv[]) {
     QF_init();       // initialize the framework and the underlying RT kernel
-    BSP_init();      // initialize the BSP
+    BSP_init((argc > 1) ? argv[1] : (void *)0); // initialize the BSP
 
     // pause execution of the test and wait for the test script to continue
     QS_TEST_PAUSE();
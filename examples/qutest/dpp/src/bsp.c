@@ -44,11 +44,11 @@ enum {
 };
 
 //............................................................................
-void BSP_init(void) {
+void BSP_init(void const * const arg) {
     BSP_randomSeed(1234U);
 
     // initialize the QS software tracing
-    if (!QS_INIT((void *)0)) {
+    if (!QS_INIT(arg)) {
         Q_ERROR();
     }
 
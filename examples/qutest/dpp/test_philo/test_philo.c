@@ -35,9 +35,9 @@
 static QActiveDummy Table_dummy;
 QActive * const AO_Table = &Table_dummy.super;
 
-int main() {
+int main(int argc, char *argv[]) {
     QF_init();       // initialize the framework and the underlying RT kernel
-    BSP_init();      // initialize the BSP
+    BSP_init((argc > 1) ? argv[1] : (void *)0); // initialize the BSP
 
     QS_OBJ_DICTIONARY(&Table_dummy);
 
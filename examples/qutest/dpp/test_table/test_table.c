@@ -49,9 +49,9 @@ QActive * const AO_Philo[N_PHILO] = {
     &Philo_dummy[4].super
 };
 
-int main() {
+int main(int argc, char *argv[]) {
     QF_init();       // initialize the framework and the underlying RT kernel
-    BSP_init();      // initialize the BSP
+    BSP_init((argc > 1) ? argv[1] : (void *)0); // initialize the BSP
 
     for (uint8_t n = 0U; n < N_PHILO; ++n) {
        QS_OBJ_ARR_DICTIONARY(&Philo_dummy[n], n);
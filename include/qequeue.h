@@ -128,5 +128,38 @@ static inline bool QEQueue_isEmpty(QEQueue const * const me) {
     return me->frontEvt == (struct QEvt *)0;
 }
 //$enddecl${QF::QEQueue} ^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^
+//$declare${QF::QDeferQueue} vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+
+//${QF::QDeferQueue} .........................................................
+//! @class QDeferQueue
+//! @extends QEQueue
+typedef struct QDeferQueue {
+// protected:
+    QEQueue super;
+
+// private:
+
+    //! @private @memberof QDeferQueue
+    //! priority of each signal (higher value is recalled first)
+    uint8_t const * sigPrio;
+
+    //! @private @memberof QDeferQueue
+    //! number of entries in the QDeferQueue::sigPrio[] table
+    uint16_t nSig;
+} QDeferQueue;
+
+//! @static @private @memberof QDeferQueue
+//! dummy static member to force QM to generate 'struct QDeferQueue'
+extern QDeferQueue const * QDeferQueue_dummy;
+
+// public:
+
+//! @public @memberof QDeferQueue
+void QDeferQueue_init(QDeferQueue * const me,
+    struct QEvt const ** const qSto,
+    uint_fast16_t const qLen,
+    uint8_t const * const sigPrio,
+    uint_fast16_t const nSig);
+//$enddecl${QF::QDeferQueue} ^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^
 
 #endif // QEQUEUE_H_
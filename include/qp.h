@@ -97,6 +97,40 @@
 #error QF_EVENT_SIZ_SIZE defined incorrectly, expected 1U, 2U, or 4U;
 #endif
 
+#ifdef QHSM_ANCESTOR_CACHE
+#if (QHSM_ANCESTOR_CACHE < 3U) || (QHSM_ANCESTOR_CACHE > 16U)
+#error QHSM_ANCESTOR_CACHE defined incorrectly, expected 3U..16U;
+#endif
+#endif // def QHSM_ANCESTOR_CACHE
+
+#ifdef QACTIVE_SIG_FILTER
+#if (QACTIVE_SIG_FILTER < 8U) || (QACTIVE_SIG_FILTER > 1024U)
+#error QACTIVE_SIG_FILTER defined incorrectly, expected 8U..1024U;
+#endif
+#endif // def QACTIVE_SIG_FILTER
+
+#ifdef QACTIVE_LAT_HIST
+#if (QACTIVE_LAT_HIST < 4U) || (QACTIVE_LAT_HIST > 254U)
+#error QACTIVE_LAT_HIST defined incorrectly, expected 4U..254U;
+#endif
+#ifndef QACTIVE_LAT_SIGS
+#define QACTIVE_LAT_SIGS 32U
+#endif
+#endif // def QACTIVE_LAT_HIST
+
+#ifdef QACTIVE_HIST
+#if (QACTIVE_HIST < 4U) || (QACTIVE_HIST > 4096U) \
+    || ((QACTIVE_HIST & (QACTIVE_HIST - 1U)) != 0U)
+#error QACTIVE_HIST defined incorrectly, expected a power of 2 in 4U..4096U;
+#endif
+#endif // def QACTIVE_HIST
+
+#ifdef QTIMEEVT_SHARDS
+#if (QTIMEEVT_SHARDS < 2U) || (QTIMEEVT_SHARDS > 64U)
+#error QTIMEEVT_SHARDS defined incorrectly, expected 2U..64U;
+#endif
+#endif // def QTIMEEVT_SHARDS
+
 //! @endcond
 //============================================================================
 
@@ -287,6 +321,20 @@ typedef struct {
 
     //! @protected @memberof QAsm
     union QAsmAttr temp;
+
+// private:
+
+#ifdef QHSM_ANCESTOR_CACHE
+    //! @private @memberof QAsm
+    //! cached superstate chain of the current state (bottom-up, incl. top)
+    QStateHandler anc[QHSM_ANCESTOR_CACHE];
+#endif // def QHSM_ANCESTOR_CACHE
+
+#ifdef QHSM_ANCESTOR_CACHE
+    //! @private @memberof QAsm
+    //! number of valid entries in QAsm::anc[]
+    uint8_t ancLen;
+#endif // def QHSM_ANCESTOR_CACHE
 } QAsm;
 
 // protected:
@@ -790,6 +838,81 @@ typedef struct {
 
 //${QF::types::QEQueue} ......................................................
 struct QEQueue;
+
+//${QF::types::QDeferQueue} ..................................................
+struct QDeferQueue;
+
+//${QF::types::QF_LAT_BINS} ..................................................
+//! number of bins in the latency histograms (4 bins per power of 2)
+#define QF_LAT_BINS 124U
+
+//${QF::types::QLatKind} .....................................................
+//! Kinds of the latency histograms
+enum QLatKind {
+    QF_LAT_QUEUE,    //!< queueing delay (from posting to QActive_get_())
+    QF_LAT_RTC,      //!< duration of the RTC step (dispatch)
+    QF_LAT_MAX_KIND
+};
+
+//${QF::types::QLatHist} .....................................................
+//! @struct QLatHist
+//! Log-linear histogram of latencies in the units of QF_LAT_TIME()
+typedef struct {
+// public:
+
+    //! # samples in each bin
+    uint32_t cnt[QF_LAT_BINS];
+
+    //! the maximum sample so far
+    uint32_t max;
+} QLatHist;
+
+// public:
+
+#ifdef QACTIVE_LAT_HIST
+//! @public @memberof QLatHist
+uint32_t QLatHist_quantile(QLatHist const * const me,
+    uint_fast16_t const permille);
+#endif // def QACTIVE_LAT_HIST
+
+//${QF::types::QHistKind} ....................................................
+//! Kinds of the entries in the AO history ("black box")
+enum QHistKind {
+    QF_HIST_POST,      //!< event posted (FIFO) to the AO
+    QF_HIST_POST_LIFO, //!< event posted (LIFO) to the AO
+    QF_HIST_DISPATCH,  //!< event removed from the queue for dispatching
+    QF_HIST_TRAN       //!< the RTC step changed the current state
+};
+
+//${QF::types::QHistEntry} ...................................................
+//! @struct QHistEntry
+//! Entry in the AO history ("black box")
+typedef struct {
+// public:
+
+    //! QF_LAT_TIME() (if provided) or the entry number
+    uint32_t stamp;
+
+    //! the signal of the event
+    QSignal sig;
+
+    //! the kind of the entry (::QHistKind)
+    uint8_t kind;
+
+    //! # free entries in the queue (255 if more)
+    uint8_t nFree;
+
+    //! sender (posts), current (dispatch) or new state
+    uintptr_t addr;
+} QHistEntry;
+
+//${QF::types::QTimeEvtPolicy} ...............................................
+//! Delivery policy of an expired time event when the AO queue is full
+enum QTimeEvtPolicy {
+    QTIMEEVT_POLICY_ASSERT, //!< assert on the full queue (default)
+    QTIMEEVT_POLICY_DROP,   //!< drop the expiry and count it
+    QTIMEEVT_POLICY_RETRY   //!< retry the posting on the next tick
+};
 //$enddecl${QF::types} ^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^
 
 //$declare${QF::QActive} vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
@@ -833,6 +956,78 @@ typedef struct QActive {
 #endif // ndef Q_UNSAFE
 
 // private:
+
+#ifdef QACTIVE_SIG_FILTER
+    //! @private @memberof QActive
+    //! signals rejected by QActive_post_() (1-bit per signal, 1 == ignore)
+    uint8_t sigFilter[(QACTIVE_SIG_FILTER + 7U) / 8U];
+#endif // def QACTIVE_SIG_FILTER
+
+#ifdef QACTIVE_SIG_FILTER
+    //! @private @memberof QActive
+    //! number of events rejected by the signal filter
+    uint32_t nFiltered;
+#endif // def QACTIVE_SIG_FILTER
+
+#ifdef QACTIVE_LAT_HIST
+    //! @private @memberof QActive
+    //! QF_LAT_TIME() of the queued events when they were posted
+    uint32_t latStamp[QACTIVE_LAT_HIST];
+#endif // def QACTIVE_LAT_HIST
+
+#ifdef QACTIVE_LAT_HIST
+    //! @private @memberof QActive
+    //! index of the oldest time stamp in QActive::latStamp[]
+    uint8_t latFront;
+#endif // def QACTIVE_LAT_HIST
+
+#ifdef QACTIVE_LAT_HIST
+    //! @private @memberof QActive
+    //! number of time stamps in QActive::latStamp[]
+    uint8_t latN;
+#endif // def QACTIVE_LAT_HIST
+
+#ifdef QACTIVE_LAT_HIST
+    //! @private @memberof QActive
+    //! signal of the event in the current RTC step
+    QSignal latSig;
+#endif // def QACTIVE_LAT_HIST
+
+#ifdef QACTIVE_LAT_HIST
+    //! @private @memberof QActive
+    //! QF_LAT_TIME() at the beginning of the current RTC step
+    uint32_t latStart;
+#endif // def QACTIVE_LAT_HIST
+
+#ifdef QACTIVE_LAT_HIST
+    //! @private @memberof QActive
+    //! histograms of the queueing delay and RTC-step duration
+    QLatHist lat[QF_LAT_MAX_KIND];
+#endif // def QACTIVE_LAT_HIST
+
+#ifdef QACTIVE_HIST
+    //! @private @memberof QActive
+    //! history of the recent posts, dispatches and transitions (ring)
+    QHistEntry hist[QACTIVE_HIST];
+#endif // def QACTIVE_HIST
+
+#ifdef QACTIVE_HIST
+    //! @private @memberof QActive
+    //! total number of entries added to QActive::hist[]
+    uint32_t histCtr;
+#endif // def QACTIVE_HIST
+
+#ifdef QACTIVE_HIST
+    //! @private @memberof QActive
+    //! signal at the beginning of the current RTC step
+    QSignal histSig;
+#endif // def QACTIVE_HIST
+
+#ifdef QACTIVE_HIST
+    //! @private @memberof QActive
+    //! state at the beginning of the current RTC step
+    uintptr_t histState;
+#endif // def QACTIVE_HIST
 } QActive;
 
 //! @static @private @memberof QActive
@@ -893,11 +1088,52 @@ bool QActive_post_(QActive * const me,
 void QActive_postLIFO_(QActive * const me,
     QEvt const * const e);
 
+//! @private @memberof QActive
+bool QActive_postCoalesce_(QActive * const me,
+    QEvt const * const e,
+    uint_fast16_t const margin,
+    void const * const sender);
+
 //! @private @memberof QActive
 QEvt const * QActive_get_(QActive * const me);
 
+#if (defined QACTIVE_LAT_HIST) || (defined QACTIVE_HIST)
+//! @private @memberof QActive
+void QActive_rtcEnd_(QActive * const me);
+#endif //  (defined QACTIVE_LAT_HIST) || (defined QACTIVE_HIST)
+
 // public:
 
+#ifdef QACTIVE_HIST
+//! @public @memberof QActive
+uint_fast16_t QActive_getHist(QActive const * const me,
+    QHistEntry * const buf,
+    uint_fast16_t const n);
+#endif // def QACTIVE_HIST
+
+#ifdef QACTIVE_LAT_HIST
+//! @public @memberof QActive
+QLatHist const * QActive_getLat(QActive const * const me,
+    enum QLatKind const kind);
+#endif // def QACTIVE_LAT_HIST
+
+#ifdef QACTIVE_SIG_FILTER
+//! @public @memberof QActive
+void QActive_ignoreSig(QActive * const me,
+    enum_t const sig);
+#endif // def QACTIVE_SIG_FILTER
+
+#ifdef QACTIVE_SIG_FILTER
+//! @public @memberof QActive
+void QActive_acceptSig(QActive * const me,
+    enum_t const sig);
+#endif // def QACTIVE_SIG_FILTER
+
+#ifdef QACTIVE_SIG_FILTER
+//! @public @memberof QActive
+uint32_t QActive_getNFiltered(QActive const * const me);
+#endif // def QACTIVE_SIG_FILTER
+
 //! @static @public @memberof QActive
 void QActive_psInit(
     QSubscrList * const subscrSto,
@@ -938,6 +1174,16 @@ uint_fast16_t QActive_flushDeferred(QActive const * const me,
     struct QEQueue * const eq,
     uint_fast16_t const num);
 
+//! @protected @memberof QActive
+bool QActive_deferPrio(QActive const * const me,
+    struct QDeferQueue * const dq,
+    QEvt const * const e);
+
+//! @protected @memberof QActive
+uint_fast16_t QActive_recallN(QActive * const me,
+    struct QEQueue * const eq,
+    uint_fast16_t const num);
+
 // private:
 
 //! @private @memberof QActive
@@ -983,6 +1229,11 @@ typedef struct QTimeEvt {
 
     //! @private @memberof QTimeEvt
     QTimeEvtCtr interval;
+
+#ifdef QTIMEEVT_SLACK
+    //! @private @memberof QTimeEvt
+    QTimeEvtCtr slackMask;
+#endif // def QTIMEEVT_SLACK
 } QTimeEvt;
 
 //! @static @private @memberof QTimeEvt
@@ -1001,6 +1252,14 @@ void QTimeEvt_armX(QTimeEvt * const me,
     QTimeEvtCtr const nTicks,
     QTimeEvtCtr const interval);
 
+#ifdef QTIMEEVT_SLACK
+//! @public @memberof QTimeEvt
+void QTimeEvt_armSlack(QTimeEvt * const me,
+    QTimeEvtCtr const nTicks,
+    QTimeEvtCtr const interval,
+    QTimeEvtCtr const slack);
+#endif // def QTIMEEVT_SLACK
+
 //! @public @memberof QTimeEvt
 bool QTimeEvt_disarm(QTimeEvt * const me);
 
@@ -1014,11 +1273,41 @@ bool QTimeEvt_wasDisarmed(QTimeEvt * const me);
 //! @public @memberof QTimeEvt
 QTimeEvtCtr QTimeEvt_currCtr(QTimeEvt const * const me);
 
+#ifdef QTIMEEVT_POST_POLICY
+//! @public @memberof QTimeEvt
+void QTimeEvt_setPolicy(QTimeEvt * const me,
+    enum QTimeEvtPolicy const policy);
+#endif // def QTIMEEVT_POST_POLICY
+
+#ifdef QTIMEEVT_POST_POLICY
+//! @static @public @memberof QTimeEvt
+uint32_t QTimeEvt_getNDropped(uint_fast8_t const tickRate);
+#endif // def QTIMEEVT_POST_POLICY
+
+#ifdef QTIMEEVT_POST_POLICY
+//! @static @public @memberof QTimeEvt
+uint32_t QTimeEvt_getNRetried(uint_fast8_t const tickRate);
+#endif // def QTIMEEVT_POST_POLICY
+
 //! @static @private @memberof QTimeEvt
 void QTimeEvt_tick_(
     uint_fast8_t const tickRate,
     void const * const sender);
 
+//! @static @private @memberof QTimeEvt
+void QTimeEvt_tickN_(
+    uint_fast8_t const tickRate,
+    QTimeEvtCtr const nTicks,
+    void const * const sender);
+
+//! @static @private @memberof QTimeEvt
+QTimeEvtCtr QTimeEvt_nextExpiry_(uint_fast8_t const tickRate);
+
+//! @static @private @memberof QTimeEvt
+void QTimeEvt_credit_(
+    uint_fast8_t const tickRate,
+    QTimeEvtCtr const nTicks);
+
 // private:
 
 #ifdef Q_UTEST
@@ -1088,6 +1377,20 @@ int_t QF_run(void);
 //! @static @public @memberof QF
 uint_fast16_t QF_getQueueMin(uint_fast8_t const prio);
 
+//${QF::QF-base::getSigLat} ..................................................
+#ifdef QACTIVE_LAT_HIST
+//! @static @public @memberof QF
+QLatHist const * QF_getSigLat(
+    enum_t const sig,
+    enum QLatKind const kind);
+#endif // def QACTIVE_LAT_HIST
+
+//${QF::QF-base::latDump} ....................................................
+#if (defined QACTIVE_LAT_HIST) && (defined Q_SPY)
+//! @static @public @memberof QF
+void QF_latDump(enum_t const rec);
+#endif //  (defined QACTIVE_LAT_HIST) && (defined Q_SPY)
+
 //${QF::QF-base::onStartup} ..................................................
 //! @static @public @memberof QF
 void QF_onStartup(void);
@@ -1222,6 +1525,18 @@ void QF_gcFromISR(QEvt const * const e);
     (QActive_post_((me_), (e_), (margin_), (void *)0))
 #endif // ndef Q_SPY
 
+//${QF-macros::QACTIVE_POST_COALESCE} ........................................
+#ifdef Q_SPY
+#define QACTIVE_POST_COALESCE(me_, e_, margin_, sender_) \
+    (QActive_postCoalesce_((me_), (e_), (margin_), (sender_)))
+#endif // def Q_SPY
+
+//${QF-macros::QACTIVE_POST_COALESCE} ........................................
+#ifndef Q_SPY
+#define QACTIVE_POST_COALESCE(me_, e_, margin_, dummy) \
+    (QActive_postCoalesce_((me_), (e_), (margin_), (void *)0))
+#endif // ndef Q_SPY
+
 //${QF-macros::QACTIVE_POST_LIFO} ............................................
 #define QACTIVE_POST_LIFO(me_, e_) \
     (QActive_postLIFO_((me_), (e_)))
@@ -81,6 +81,8 @@ void QF_bzero_(
 // In ::QTimeEvt this attribute is NOT used for reference counting.
 #define QTE_IS_LINKED      (1U << 7U)
 #define QTE_WAS_DISARMED   (1U << 6U)
+#define QTE_POLICY         0x30U
+#define QTE_POLICY_SHIFT   4U
 #define QTE_TICK_RATE      0x0FU
 
 //! @private @memberof QEvt
@@ -93,6 +95,40 @@ static inline void QEvt_refCtr_dec_(QEvt const *me) {
     --((QEvt *)me)->refCtr_;
 }
 
+#ifdef QACTIVE_SIG_FILTER
+//! @private @memberof QActive
+static inline bool QActive_sigIgnored_(QActive const * const me,
+    QSignal const sig)
+{
+    return ((uint_fast16_t)sig < (uint_fast16_t)QACTIVE_SIG_FILTER)
+        && ((me->sigFilter[(uint_fast16_t)sig >> 3U]
+             & (uint8_t)(1U << ((uint_fast16_t)sig & 7U))) != 0U);
+}
+#endif // def QACTIVE_SIG_FILTER
+
+#ifdef QACTIVE_LAT_HIST
+// QActive::latN when the time stamps no longer match the queue
+#define QACTIVE_LAT_OFF_ 0xFFU
+
+//! @private @memberof QActive
+void QActive_latPost_(QActive * const me, bool const lifo);
+#endif // def QACTIVE_LAT_HIST
+
+#ifdef QACTIVE_HIST
+//! @private @memberof QActive
+void QActive_histAdd_(QActive * const me,
+    enum QHistKind const kind,
+    QSignal const sig,
+    uintptr_t const addr);
+#endif // def QACTIVE_HIST
+
+#if (defined QACTIVE_LAT_HIST) || (defined QACTIVE_HIST)
+//! end of the RTC step of the AO (in the event loops after dispatch)
+#define QACTIVE_RTC_END_(me_) (QActive_rtcEnd_((me_)))
+#else
+#define QACTIVE_RTC_END_(me_) ((void)0)
+#endif
+
 #define QACTIVE_CAST_(ptr_) ((QActive *)(ptr_))
 #define Q_UINTPTR_CAST_(ptr_) ((uintptr_t)(ptr_))
 
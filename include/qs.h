@@ -192,7 +192,19 @@ enum QSpyPre {
     QS_MTX_BLOCK_ATTEMPT, //!< a mutex blocking was attempted
     QS_MTX_UNLOCK_ATTEMPT,//!< a mutex unlock was attempted
 
-    // [81]
+    // [81] Additional Active Object (AO) records
+    QS_QF_ACTIVE_POST_FILTERED,//!< event rejected by the AO signal filter
+    QS_QF_ACTIVE_POST_COALESCE,//!< event replaced a pending event in AO
+
+    // [83] Additional Time Event (TE) records
+    QS_QF_TIMEEVT_POST_DROP, //!< time event expiry dropped (AO queue full)
+    QS_QF_TIMEEVT_POST_RETRY,//!< time event expiry retried on the next tick
+
+    // [85] Miscellaneous QS records (not maskable)
+    QS_OVERFLOW,          //!< reports the QS buffer overflow counters
+    QS_TIME_INFO,         //!< reports the QS time-stamp source (after info)
+
+    // [87]
     QS_PRE_MAX            //!< the # predefined signals
 };
 
@@ -302,6 +314,9 @@ typedef struct {
 // public:
     uint8_t glb[16];
     uint8_t loc[16];
+#ifdef QS_SMP_MAX
+    uint8_t smp[16];
+#endif // def QS_SMP_MAX
 } QS_Filter;
 
 //${QS::filters::filt_} ......................................................
@@ -328,9 +343,32 @@ extern QS_Filter QS_filt_;
 //${QS-macros::QS_LOC_FILTER} ................................................
 #define QS_LOC_FILTER(qs_id_) (QS_locFilter_((int_fast16_t)(qs_id_)))
 
+//${QS-macros::QS_SMP_FILTER} ................................................
+#ifdef QS_SMP_MAX
+#define QS_SMP_FILTER(rec_, nth_, rate_, burst_) \
+    (QS_smpFilter_((uint_fast8_t)(rec_), (uint_fast16_t)(nth_), \
+                   (uint_fast8_t)(rate_), (uint_fast8_t)(burst_)))
+#endif // def QS_SMP_MAX
+
+//${QS-macros::QS_SMP_FILTER} ................................................
+#ifndef QS_SMP_MAX
+#define QS_SMP_FILTER(rec_, nth_, rate_, burst_) ((void)0)
+#endif // ndef QS_SMP_MAX
+
+//${QS-macros::QS_SMP_TICK} ..................................................
+#ifdef QS_SMP_MAX
+#define QS_SMP_TICK() (QS_smpTick_())
+#endif // def QS_SMP_MAX
+
+//${QS-macros::QS_SMP_TICK} ..................................................
+#ifndef QS_SMP_MAX
+#define QS_SMP_TICK() ((void)0)
+#endif // ndef QS_SMP_MAX
+
 //${QS-macros::QS_BEGIN_ID} ..................................................
 #define QS_BEGIN_ID(rec_, qs_id_) \
-if (QS_GLB_CHECK_(rec_) && QS_LOC_CHECK_(qs_id_)) { \
+if (QS_REC_CHECK_(rec_) && QS_GLB_CHECK_(rec_) \
+    && QS_LOC_CHECK_(qs_id_) && QS_SMP_CHECK_(rec_, qs_id_)) { \
     QS_CRIT_STAT \
     QS_CRIT_ENTRY(); \
     QS_MEM_SYS(); \
@@ -347,9 +385,20 @@ if (QS_GLB_CHECK_(rec_) && QS_LOC_CHECK_(qs_id_)) { \
 //${QS-macros::QS_FLUSH} .....................................................
 #define QS_FLUSH() (QS_onFlush())
 
+//${QS-macros::QS_OVERFLOW_REPORT} ...........................................
+#ifdef QS_OVERFLOW_POLICY
+#define QS_OVERFLOW_REPORT() (QS_overflow_pre_())
+#endif // def QS_OVERFLOW_POLICY
+
+//${QS-macros::QS_OVERFLOW_REPORT} ...........................................
+#ifndef QS_OVERFLOW_POLICY
+#define QS_OVERFLOW_REPORT() ((void)0)
+#endif // ndef QS_OVERFLOW_POLICY
+
 //${QS-macros::QS_BEGIN_INCRIT} ..............................................
 #define QS_BEGIN_INCRIT(rec_, qs_id_) \
-if (QS_GLB_CHECK_(rec_) && QS_LOC_CHECK_(qs_id_)) { \
+if (QS_REC_CHECK_(rec_) && QS_GLB_CHECK_(rec_) \
+    && QS_LOC_CHECK_(qs_id_) && QS_SMP_CHECK_(rec_, qs_id_)) { \
     QS_beginRec_((uint_fast8_t)(rec_)); \
     QS_TIME_PRE_(); {
 
@@ -368,6 +417,70 @@ if (QS_GLB_CHECK_(rec_) && QS_LOC_CHECK_(qs_id_)) { \
     (((uint_fast8_t)QS_filt_.loc[(uint_fast8_t)(qs_id_) >> 3U] \
           & ((uint_fast8_t)1U << ((uint_fast8_t)(qs_id_) & 7U))) != 0U)
 
+//${QS-macros::QS_SMP_CHECK_} ................................................
+#ifdef QS_SMP_MAX
+#define QS_SMP_CHECK_(rec_, qs_id_) \
+    ((((uint_fast8_t)QS_filt_.smp[(uint_fast8_t)(rec_) >> 3U] \
+          & ((uint_fast8_t)1U << ((uint_fast8_t)(rec_) & 7U))) == 0U) \
+     || QS_smpCheck_((uint_fast8_t)(rec_), (uint_fast8_t)(qs_id_)))
+#endif // def QS_SMP_MAX
+
+//${QS-macros::QS_SMP_CHECK_} ................................................
+#ifndef QS_SMP_MAX
+#define QS_SMP_CHECK_(rec_, qs_id_) (true)
+#endif // ndef QS_SMP_MAX
+
+//${QS-macros::QS_REC_GROUP} .................................................
+#define QS_REC_GROUP(grp_) \
+    (((grp_) == QS_ALL_RECORDS) ? 0x3FFFU \
+     : ((grp_) == QS_UA_RECORDS) ? (0x1FU << 9U) \
+     : (1U << ((uint_fast8_t)(grp_) - (uint_fast8_t)QS_SM_RECORDS)))
+
+//${QS-macros::QS_REC_CHECK_} ................................................
+#ifdef QS_REC_EXCLUDE
+#define QS_REC_CHECK_(rec_) \
+    (((QS_REC_EXCL_WORD_((uint_fast8_t)(rec_) >> 5U) \
+          >> ((uint_fast8_t)(rec_) & 31U)) & 1U) == 0U)
+
+// the excluded records in the 32-bit word 'w_' of the global filter
+#define QS_REC_EXCL_WORD_(w_) \
+    (((w_) == 0U) ? QS_REC_EXCL_W0_ \
+     : ((w_) == 1U) ? QS_REC_EXCL_W1_ \
+     : ((w_) == 2U) ? QS_REC_EXCL_W2_ \
+     : QS_REC_EXCL_W3_)
+
+// the records of the group 'grp_' (in the given word) if it is excluded
+#define QS_REC_EXCL_(grp_, mask_) \
+    (((((uint32_t)(QS_REC_EXCLUDE) >> (grp_)) & 1U) != 0U) \
+     ? (uint32_t)(mask_) : 0U)
+
+// records 0..31 (see also QS_glbFilter_())
+#define QS_REC_EXCL_W0_ (QS_REC_EXCL_(0U, 0x000003FEU) \
+    | QS_REC_EXCL_(1U, 0x0007FC00U) | QS_REC_EXCL_(2U, 0x00780000U) \
+    | QS_REC_EXCL_(3U, 0x03000000U) | QS_REC_EXCL_(5U, 0xFC800000U))
+
+// records 32..63
+#define QS_REC_EXCL_W1_ (QS_REC_EXCL_(0U, 0x03800000U) \
+    | QS_REC_EXCL_(1U, 0x00002000U) | QS_REC_EXCL_(2U, 0x00004000U) \
+    | QS_REC_EXCL_(3U, 0x00008000U) | QS_REC_EXCL_(4U, 0x0000003FU) \
+    | QS_REC_EXCL_(5U, 0x00001FC0U) | QS_REC_EXCL_(6U, 0x003F0000U))
+
+// records 64..95
+#define QS_REC_EXCL_W2_ (QS_REC_EXCL_(1U, 0x00060000U) \
+    | QS_REC_EXCL_(4U, 0x00180000U) | QS_REC_EXCL_(7U, 0x00000780U) \
+    | QS_REC_EXCL_(8U, 0x0001F800U))
+
+// records 96..127 (user records)
+#define QS_REC_EXCL_W3_ (QS_REC_EXCL_(9U, 0x000001F0U) \
+    | QS_REC_EXCL_(10U, 0x00003E00U) | QS_REC_EXCL_(11U, 0x0007C000U) \
+    | QS_REC_EXCL_(12U, 0x00F80000U) | QS_REC_EXCL_(13U, 0x1F000000U))
+#endif // def QS_REC_EXCLUDE
+
+//${QS-macros::QS_REC_CHECK_} ................................................
+#ifndef QS_REC_EXCLUDE
+#define QS_REC_CHECK_(rec_) (true)
+#endif // ndef QS_REC_EXCLUDE
+
 //${QS-macros::QS_REC_DONE} ..................................................
 #ifndef QS_REC_DONE
 #define QS_REC_DONE() ((void)0)
@@ -588,6 +701,12 @@ typedef struct {
     uint8_t volatile chksum;
     uint8_t volatile critNest;
     uint8_t flags;
+#ifdef QS_FAST_FRAMING
+    QSCtr recHead;
+#endif
+#if (defined QS_OVERFLOW_POLICY) && (QS_OVERFLOW_POLICY != 0U)
+    QSCtr recBeg;
+#endif
 } QS_Attr;
 
 extern QS_Attr QS_priv_;
@@ -660,6 +779,22 @@ void QS_assertion_pre_(
 
 void QS_target_info_pre_(uint8_t const isReset);
 
+#ifdef QS_OVERFLOW_POLICY
+void QS_overflow_pre_(void);
+#endif
+
+#ifdef QS_SMP_MAX
+bool QS_smpFilter_(
+    uint_fast8_t const rec,
+    uint_fast16_t const nth,
+    uint_fast8_t const rate,
+    uint_fast8_t const burst);
+void QS_smpTick_(void);
+bool QS_smpCheck_(
+    uint_fast8_t const rec,
+    uint_fast8_t const qs_id);
+#endif
+
 //! @endcond
 //============================================================================
 
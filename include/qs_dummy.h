@@ -90,6 +90,9 @@
 #define QS_ENUM_DICTIONARY(value_, group_)  ((void)0)
 #define QS_ASSERTION(module_, loc_, delay_) ((void)0)
 #define QS_FLUSH()                      ((void)0)
+#define QS_OVERFLOW_REPORT()            ((void)0)
+#define QS_SMP_FILTER(rec_, nth_, rate_, burst_) ((void)0)
+#define QS_SMP_TICK()                   ((void)0)
 
 #define QS_TEST_PROBE_DEF(fun_)
 #define QS_TEST_PROBE(code_)
@@ -75,7 +75,8 @@ enum QSpyRxRecords {
 
 //----------------------------------------------------------------------------
 #define QS_BEGIN_PRE_(rec_, qs_id_) \
-    if (QS_GLB_CHECK_(rec_) && QS_LOC_CHECK_(qs_id_)) { \
+    if (QS_REC_CHECK_(rec_) && QS_GLB_CHECK_(rec_) \
+        && QS_LOC_CHECK_(qs_id_) && QS_SMP_CHECK_(rec_, qs_id_)) { \
         QS_beginRec_((uint_fast8_t)(rec_));
 #define QS_END_PRE_()           QS_endRec_(); }
 
@@ -146,6 +147,64 @@ enum QSpyRxRecords {
     #define QS_TEC_PRE_(ctr_)   QS_u32_raw_((uint32_t)(ctr_))
 #endif
 
+//----------------------------------------------------------------------------
+// The QS-TX state (buffer, head, sequence and checksum) used to produce
+// the trace records. A QS port can redefine QS_TX_ to select a different
+// buffer for the calling thread, such as a per-thread trace buffer
+// (see QS_THREAD_BUF in the POSIX ports). In that case, the port also
+// defines QS_TX_BEGIN_() and QS_TX_END_() called at the beginning and
+// at the end of every record.
+#ifndef QS_TX_
+#define QS_TX_ QS_priv_
+#define QS_TX_SHARED_() true
+#else
+// does the calling thread produce the records into the shared QS buffer?
+#define QS_TX_SHARED_() (&QS_TX_ == &QS_priv_)
+#endif
+
+// With QS_OVERFLOW_POLICY 2U, a QS port can define QS_TX_WAIT_() to wait
+// briefly for free space in the QS buffer. QS_TX_WAIT_() is called outside
+// of critical section before producing the dictionary records.
+#ifndef QS_TX_WAIT_
+#define QS_TX_WAIT_() ((void)0)
+#endif
+
+// A QS port can define QS_TARGET_INFO_EXT_() to produce additional records
+// (e.g., QS_TIME_INFO) right after the QS_TARGET_INFO record. The fixed
+// format of QS_TARGET_INFO expected by QSPY remains unchanged.
+#ifndef QS_TARGET_INFO_EXT_
+#define QS_TARGET_INFO_EXT_() ((void)0)
+#endif
+
+//----------------------------------------------------------------------------
+#ifdef QS_OVERFLOW_POLICY
+
+#if (QS_OVERFLOW_POLICY > 2U)
+#error QS_OVERFLOW_POLICY defined incorrectly, expected 0U, 1U, or 2U;
+#endif
+
+// free space [bytes] in the QS buffer needed to produce a record, when
+// the newest records are dropped (QS_OVERFLOW_POLICY 1U or 2U). This is
+// also the hard limit of the length of a record, see QS_endRec_()
+#ifndef QS_REC_MAX
+#define QS_REC_MAX 128U
+#endif
+#if (QS_REC_MAX < 48U)
+#error QS_REC_MAX defined incorrectly, expected at least 48U;
+#endif
+
+void QS_dropRec_(uint8_t const rec);   // count a dropped record
+void QS_overrun_(QSCtr const nBytes);  // count the overwritten old data
+
+
+#endif // def QS_OVERFLOW_POLICY
+
+#ifdef QS_SMP_MAX
+#if (QS_SMP_MAX < 1U) || (QS_SMP_MAX > 16U)
+#error QS_SMP_MAX defined incorrectly, expected 1U..16U;
+#endif
+#endif // def QS_SMP_MAX
+
 //----------------------------------------------------------------------------
 #define QS_INSERT_BYTE_(b_) \
     buf[head] = (b_);       \
@@ -154,6 +213,8 @@ enum QSpyRxRecords {
         head = 0U;          \
     }
 
+#ifndef QS_FAST_FRAMING
+
 #define QS_INSERT_ESC_BYTE_(b_)                      \
     chksum = (uint8_t)(chksum + (b_));               \
     if (((b_) != QS_FRAME) && ((b_) != QS_ESC)) {    \
@@ -162,9 +223,44 @@ enum QSpyRxRecords {
     else {                                           \
         QS_INSERT_BYTE_(QS_ESC)                      \
         QS_INSERT_BYTE_((uint8_t)((b_) ^ QS_ESC_XOR))\
-        ++QS_priv_.used;                             \
+        ++QS_TX_.used;                               \
     }
 
+#else // QS_FAST_FRAMING
+
+#if (!defined QS_OVERFLOW_POLICY) || (QS_OVERFLOW_POLICY == 0U)
+#error QS_FAST_FRAMING requires QS_OVERFLOW_POLICY 1U or 2U
+#endif
+#if (defined __BYTE_ORDER__) && (__BYTE_ORDER__ != __ORDER_LITTLE_ENDIAN__)
+#error QS_FAST_FRAMING requires a little-endian target
+#endif
+
+#include <string.h>  // for memcpy()
+
+// the first byte of every fast record, which allows the tools to
+// resynchronize with the stream after a lost or corrupted part of it
+#define QS_FAST_SYNC 0xA5U
+
+// the fast framing inserts the bytes without escaping and without
+// the per-byte checksum (see QS_FAST_FRAMING in qp_config.h)
+#define QS_INSERT_ESC_BYTE_(b_) QS_INSERT_BYTE_(b_)
+
+// insert 'n_' bytes from 'src_' (with a single memcpy() if contiguous)
+#define QS_INSERT_BLOCK_(src_, n_)                      \
+    if ((QSCtr)(end - head) > (QSCtr)(n_)) {            \
+        memcpy(&buf[head], (src_), (size_t)(n_));       \
+        head += (QSCtr)(n_);                            \
+    }                                                   \
+    else {                                              \
+        uint8_t const *pb_ = (uint8_t const *)(src_);   \
+        for (QSCtr i_ = (QSCtr)(n_); i_ != 0U; --i_) {  \
+            QS_INSERT_BYTE_(*pb_)                       \
+            ++pb_;                                      \
+        }                                               \
+    }
+
+#endif // QS_FAST_FRAMING
+
 //----------------------------------------------------------------------------
 #if (defined Q_UTEST) && (Q_UTEST != 0)
 void QS_processTestEvts_(void);
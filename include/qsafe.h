@@ -62,6 +62,10 @@ extern "C" {
 #define QF_CRIT_EXIT() ((void)0)
 #endif
 
+#ifndef Q_ON_ERROR_HOOK_
+#define Q_ON_ERROR_HOOK_() ((void)0)
+#endif
+
 //$declare${QP-FuSa::enabled} vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
 
 //${QP-FuSa::enabled::Q_DEFINE_THIS_MODULE} ..................................
@@ -70,17 +74,19 @@ extern "C" {
 
 //${QP-FuSa::enabled::Q_ASSERT_INCRIT} .......................................
 #define Q_ASSERT_INCRIT(id_, expr_)  \
-    ((expr_) ? ((void)0) : Q_onError(&Q_this_module_[0], (id_)))
+    ((expr_) ? ((void)0) \
+        : (Q_ON_ERROR_HOOK_(), Q_onError(&Q_this_module_[0], (id_))))
 
 //${QP-FuSa::enabled::Q_ERROR_INCRIT} ........................................
 #define Q_ERROR_INCRIT(id_)  \
-    (Q_onError(&Q_this_module_[0], (id_)))
+    (Q_ON_ERROR_HOOK_(), Q_onError(&Q_this_module_[0], (id_)))
 
 //${QP-FuSa::enabled::Q_ASSERT_ID} ...........................................
 #define Q_ASSERT_ID(id_, expr_) do { \
     QF_CRIT_STAT \
     QF_CRIT_ENTRY(); \
-    (expr_) ? ((void)0) : Q_onError(&Q_this_module_[0], (id_)); \
+    (expr_) ? ((void)0) \
+        : (Q_ON_ERROR_HOOK_(), Q_onError(&Q_this_module_[0], (id_))); \
     QF_CRIT_EXIT(); \
 } while (false)
 
@@ -88,6 +94,7 @@ extern "C" {
 #define Q_ERROR_ID(id_) do { \
     QF_CRIT_STAT \
     QF_CRIT_ENTRY(); \
+    Q_ON_ERROR_HOOK_(); \
     Q_onError(&Q_this_module_[0], (id_)); \
     QF_CRIT_EXIT(); \
 } while (false)
@@ -100,6 +100,15 @@
 // <i>Default: 2
 #define Q_SIGNAL_SIZE  2U
 
+// <o>QHsm cached superstate chain (QHSM_ANCESTOR_CACHE) <3-16>
+// <i>When defined, every QHsm (and QActive) caches the superstate chain
+// <i>of its current state, which is rebuilt only when the state changes.
+// <i>QHsm_isIn() and QHsm_childState() then become array scans without
+// <i>calling state handlers and without entering critical sections.
+// <i>The value is the maximum nesting depth (including the top state).
+// <i>Default: undefined (no cache)
+//#define QHSM_ANCESTOR_CACHE 6U
+
 // </h>
 
 //..........................................................................
@@ -139,6 +148,116 @@
 //#define QACTIVE_CAN_STOP
 // </c>
 
+// <c1>Time event slack (QTIMEEVT_SLACK)
+// <i>Enable QTimeEvt_armSlack(), which lets the framework delay
+// <i>the expiry of a time event by up to the given slack [ticks], so
+// <i>that the expiries of many time events are batched at the same ticks.
+//#define QTIMEEVT_SLACK
+// </c>
+
+// <c1>Time event delivery policy (QTIMEEVT_POST_POLICY)
+// <i>Enable QTimeEvt_setPolicy(), which selects what happens when
+// <i>an expired time event cannot be posted, because the AO queue is full:
+// <i>assert (default), drop the expiry, or retry on the next tick.
+// <i>Dropped and retried expiries are counted per tick rate and traced
+// <i>(QS_QF_TIMEEVT_POST_DROP, QS_QF_TIMEEVT_POST_RETRY).
+//#define QTIMEEVT_POST_POLICY
+// </c>
+
+// <o>Time event list shards (QTIMEEVT_SHARDS) <2-64>
+// <i>When defined, the time events of every tick rate are kept in
+// <i>this many separate lists (shards) by the priority of the owning AO,
+// <i>each protected by its own lock instead of the critical section,
+// <i>so that arming/disarming time events in different AOs does not
+// <i>contend for the global critical section. The QF port must provide
+// <i>the shard locks (QTIMEEVT_SHARD_LOCK_()), currently POSIX and POSIX-QV.
+// <i>Not available in the tickless mode (QF_TICKLESS).
+// <i>Default: undefined (one time event list per tick rate)
+//#define QTIMEEVT_SHARDS 8U
+
+// <o>Active Object signal filter (QACTIVE_SIG_FILTER) <8-1024>
+// <i>When defined, every AO has a bitmask of signals that are rejected
+// <i>by QActive_post_() (and therefore also by QActive_publish_())
+// <i>before they are queued. The mask is maintained with
+// <i>QActive_ignoreSig()/QActive_acceptSig(), for example from the
+// <i>entry/exit actions of states that ignore chatty signals.
+// <i>Rejected events are counted and traced (QS_QF_ACTIVE_POST_FILTERED).
+// <i>The value is the number of signals covered by the mask.
+// <i>Default: undefined (no signal filter)
+//#define QACTIVE_SIG_FILTER 64U
+
+// <o>Latency histograms of the AOs (QACTIVE_LAT_HIST) <4-254>
+// <i>When defined, the events are time-stamped with QF_LAT_TIME() (port)
+// <i>when posted, and every AO collects log-linear histograms of the
+// <i>queueing delay (from posting to QActive_get_()) and of the RTC-step
+// <i>duration. The value is the max number of time-stamped events in the
+// <i>queue of an AO (deeper queues are not measured until they empty).
+// <i>Also collected for the signals below QACTIVE_LAT_SIGS (default 32U).
+// <i>See QActive_getLat(), QF_getSigLat(), QLatHist_quantile(), and
+// <i>QF_latDump() (QS application-specific record).
+// <i>Default: undefined (no latency histograms)
+//#define QACTIVE_LAT_HIST 32U
+
+// <o>History ("black box") of the AOs (QACTIVE_HIST) <4-4096>
+// <i>When defined, every AO records its last QACTIVE_HIST posts,
+// <i>dispatches, and state transitions as compact binary entries (time
+// <i>stamp or sequence number, signal, free queue entries, and sender or
+// <i>state). The value must be a power of 2. See QActive_getHist().
+// <i>The POSIX ports dump the histories automatically before Q_onError()
+// <i>(to stderr or to the file set by QF_histFile()).
+// <i>Default: undefined (no AO histories)
+//#define QACTIVE_HIST 32U
+
+// <c1>Catch up with the missed clock ticks in bulk (QF_TICK_BULK)
+// <i>Supported only in the POSIX ports (posix, posix-qv).
+// <i>When the ticker thread wakes up late by whole tick periods, the
+// <i>QF_TICK_CATCH_UP overrun policy calls QF_onClockTick() only once,
+// <i>and QTIMEEVT_TICK_X() (redefined by the port) advances the time
+// <i>events by all the missed ticks in one pass (QTimeEvt_tickN_()).
+// <i>When undefined, QTIMEEVT_TICK_X() is not redefined and the missed
+// <i>ticks are processed back-to-back.
+//#define QF_TICK_BULK
+// </c>
+
+// <c1>Tickless (dynamic-tick) mode (QF_TICKLESS)
+// <i>Supported only in the POSIX ports (posix, posix-qv).
+// <i>The ticker thread sleeps until the earliest time event expiry
+// <i>instead of waking up every clock tick. The ticks elapsed in between
+// <i>are credited to the time events in bulk, so QF_onClockTick() is
+// <i>called only for the ticks that expire a time event or that end
+// <i>the polling period QF_TICKLESS_POLL (see below).
+//#define QF_TICKLESS
+// </c>
+
+// <o>Tickless mode polling period [ticks] (QF_TICKLESS_POLL) <0-255>
+// <i>Used only with QF_TICKLESS. The tickless ticker calls
+// <i>QF_onClockTick() at least every QF_TICKLESS_POLL clock ticks, so
+// <i>that the applications polling their inputs (keyboard, QS-RX) in
+// <i>QF_onClockTick() keep working, only at the lower rate.
+// <i>0 means no polling: QF_onClockTick() is called only when a time
+// <i>event expires, and the inputs must then be polled elsewhere.
+// <i>Default: 10
+//#define QF_TICKLESS_POLL 10U
+
+// <c1>Clock tick and I/O readiness in epoll (QF_EPOLL)
+// <i>Supported only in the POSIX ports (posix, posix-qv) on Linux.
+// <i>The ticker thread waits in epoll on a periodic timerfd, and
+// <i>the applications can add their file descriptors to the same epoll
+// <i>set (QFdEvt_watch()) to receive the readiness as QFdEvt events
+// <i>posted directly to their AOs. Cannot be combined with QF_TICKLESS.
+//#define QF_EPOLL
+// </c>
+
+// <o>High-resolution deadline timers (QF_MAX_HR_TIMER) <1-65535>
+// <i>Supported only in the POSIX ports (posix, posix-qv).
+// <i>When defined, the QHrTimer deadline timers can be armed with
+// <i>absolute or relative CLOCK_MONOTONIC nanoseconds, independent of
+// <i>the clock tick. The expired timers are posted to the owning AOs
+// <i>as normal events. The value is the maximum number of timers armed
+// <i>at the same time.
+// <i>Default: undefined (no high-resolution timers)
+//#define QF_MAX_HR_TIMER 16U
+
 // <o>Event size (QF_EVENT_SIZ_SIZE)
 //   <1U=>1
 //   <2U=>2 (default)
@@ -215,6 +334,118 @@
 // <i>Default: 4 (4G address space)
 #define QS_FUN_PTR_SIZE 4U
 
+// <o>Per-thread trace buffers (QS_THREAD_BUF) <4096-65535>
+// <i>Supported only in the POSIX ports (posix, posix-qv).
+// <i>When defined, the AO threads produce their trace records without
+// <i>locking into their own ring buffers of this size [bytes].
+// <i>A background thread merges the records into the main QS buffer
+// <i>in the order of their time stamps (QS_onGetTime()),
+// <i>so the output stays compatible with QSPY.
+// <i>Default: undefined (all threads use the main QS buffer)
+//#define QS_THREAD_BUF 16384U
+
+// <o>QS output batch (QS_TX_BATCH) <1-65535>
+// <i>Supported only in the POSIX ports (posix, posix-qv).
+// <i>When defined, a dedicated thread sends the QS output, when
+// <i>at least this many bytes [bytes] are buffered, or when
+// <i>QS_TX_LATENCY [us] elapses (default 10000U).
+// <i>No application thread waits for the QS output then.
+// <i>Default: undefined (QS output sent by the application threads)
+//#define QS_TX_BATCH 1024U
+
+// <o>QS buffer overflow policy (QS_OVERFLOW_POLICY)
+//   <0U=>0 (overwrite the oldest data)
+//   <1U=>1 (drop the newest records)
+//   <2U=>2 (drop the newest, but wait briefly before dictionaries)
+// <i>What happens when a new record does not fit in the QS buffer.
+// <i>With policies 1 and 2, a record is dropped when the free space
+// <i>is less than QS_REC_MAX [bytes] (default 128U, at least 48U), so
+// <i>the oldest data are never overwritten. The free space counts the
+// <i>data handed over to the output (QS_getBlock()) as free, so the
+// <i>guarantee holds only when the output sends a copy (QS_TX_BATCH in
+// <i>the POSIX ports) or sends the block before new records are made.
+// <i>Policy 2 waits (outside critical sections) only before the
+// <i>dictionary records; all other records are made inside critical
+// <i>sections and are dropped as with policy 1. QS_REC_MAX is then also
+// <i>the hard limit of a record: QS_STR() and QS_MEM() (also in the
+// <i>dictionaries) are truncated to fit, and a longer record asserts
+// <i>(count 2 bytes per data byte for the worst-case escaping).
+// <i>The overwritten bytes and the dropped records of each type are
+// <i>counted and reported in the QS_OVERFLOW record by QS_OVERFLOW_REPORT().
+// <i>Default: undefined (overwrite the oldest data, no accounting)
+//#define QS_OVERFLOW_POLICY 1U
+
+// <c1>Fast QS framing (QS_FAST_FRAMING)
+// <i>Length-prefixed trace records without the HDLC escaping and without
+// <i>the per-byte checksum, for local transports (file, shared memory,
+// <i>Unix socket) on little-endian hosted targets. Multi-byte data are
+// <i>copied with memcpy(). Requires QS_OVERFLOW_POLICY 1U or 2U.
+// <i>Every record begins with the sync byte QS_FAST_SYNC (0xA5).
+// <i>The tool ports/posix/qs_fast2hdlc.c converts the fast trace offline
+// <i>to the classic QS stream for QSPY and resynchronizes at the sync
+// <i>bytes after a lost or corrupted part of the trace.
+//#define QS_FAST_FRAMING
+// </c>
+
+// <c1>CRC of the fast QS records (QS_FAST_CRC)
+// <i>Appends CRC-16/CCITT of every fast record (QS_FAST_FRAMING),
+// <i>computed in bulk when the record is complete.
+//#define QS_FAST_CRC
+// </c>
+
+// <o>QS trace file ring size (QS_TRACE_FILE) <4096-1073741824>
+// <i>Supported only in the POSIX ports (posix, posix-qv).
+// <i>When defined, QS_INIT("file:<path>") writes the QS output into
+// <i>a memory-mapped circular file with a ring of this size [bytes]
+// <i>instead of sending it to QSPY. The file header holds the write
+// <i>position and the dictionaries (QS_TRACE_DICT [bytes], default
+// <i>16384U), so the file survives a crash of the application.
+// <i>The tool ports/posix/qs_trace2qspy.c extracts the file offline
+// <i>into a binary for QSPY.
+// <i>Default: undefined (no trace file)
+//#define QS_TRACE_FILE 1048576U
+
+// <o>Sampled and rate-limited QS records (QS_SMP_MAX) <1-16>
+// <i>Max number of record types with sampling or rate limit.
+// <i>QS_SMP_FILTER(rec, nth, rate, burst) passes only 1 in 'nth' records
+// <i>of the given type and, for each QS-ID (e.g., AO priority), at most
+// <i>'burst' records, refilled by 'rate' at every QS_SMP_TICK().
+// <i>Also settable from QSPY by the global filter with 5 bytes of data:
+// <i>rec, nth (2 bytes, little-endian), rate, burst (all 0: remove).
+// <i>The other records cost only one extra bit test.
+// <i>Default: undefined (no sampling or rate limits)
+//#define QS_SMP_MAX 4U
+
+// <o>Record groups excluded at compile time (QS_REC_EXCLUDE) <0-0x3FFF>
+// <i>Bit-mask of the QS record groups that are never produced, so that
+// <i>their QS_BEGIN_PRE_()/QS_BEGIN_ID() become dead code (no filter
+// <i>checks or argument evaluation). The bits are in the order of the
+// <i>groups: SM=0x1, AO=0x2, EQ=0x4, MP=0x8, TE=0x10, QF=0x20, SC=0x40,
+// <i>SEM=0x80, MTX=0x100, U0..U4=0x200..0x2000, for example:
+// <i>(QS_REC_GROUP(QS_MP_RECORDS) | QS_REC_GROUP(QS_TE_RECORDS)) = 0x18
+// <i>The not-maskable records (dictionaries, etc.) are never excluded.
+// <i>Default: undefined (all records can be enabled at run time)
+//#define QS_REC_EXCLUDE 0x18U
+
+// <c1>TSC time stamps (QS_TSC_TIME)
+// <i>Supported only in the POSIX ports (posix, posix-qv) on x86-64.
+// <i>QS_onGetTime() reads the invariant time-stamp counter (rdtsc),
+// <i>calibrated in QS_onStartup(), instead of calling clock_gettime().
+// <i>The time source and the TSC frequency are reported in the
+// <i>QS_TIME_INFO record after QS_TARGET_INFO. Falls back to
+// <i>clock_gettime() without the invariant TSC.
+//#define QS_TSC_TIME
+// </c>
+
+// <c1>Fork-server for QUTest resets (QS_FORK_RESET)
+// <i>Supported only in the posix-qutest port.
+// <i>The test process is forked from the snapshot taken in QS_onStartup()
+// <i>(connected to QSPY), and a new one is forked after every reset of
+// <i>the Target, instead of restarting and reconnecting the process.
+// <i>(The QUTest builds can pass it as DEF=-DQS_FORK_RESET to make.)
+//#define QS_FORK_RESET
+// </c>
+
 // <o>QS buffer counter size (QS_CTR_SIZE)
 //   <1U=>1
 //   <2U=>2 (default)
@@ -43,16 +43,20 @@
 
 #include "safe_std.h" // portable "safe" <stdio.h>/<string.h> facilities
 #include <stdlib.h>
-#include <sys/select.h>
+#include <poll.h>
 #include <sys/types.h>
 #include <sys/socket.h>
 #include <netinet/in.h>
+#include <netinet/tcp.h>
 #include <netdb.h>
 #include <errno.h>
 #include <time.h>
 #include <unistd.h>
 #include <fcntl.h>
 #include <signal.h>
+#ifdef QS_FORK_RESET
+#include <sys/wait.h>
+#endif
 
 #define QS_TX_SIZE     (8*1024)
 #define QS_RX_SIZE     (2*1024)
@@ -74,30 +78,26 @@ static void sigIntHandler(int dummy) {
     exit(-1);
 }
 
-//............................................................................
-uint8_t QS_onStartup(void const *arg) {
-
-    static uint8_t qsBuf[QS_TX_SIZE];   // buffer for QS-TX channel
-    QS_initBuf(qsBuf, sizeof(qsBuf));
-
-    static uint8_t qsRxBuf[QS_RX_SIZE]; // buffer for QS-RX channel
-    QS_rxInitBuf(qsRxBuf, sizeof(qsRxBuf));
+#ifdef QS_FORK_RESET
+static void forkServer(void); // prototype
+static bool isConnected(void); // prototype
+#endif
+static bool waitWritable(void); // prototype
 
+//............................................................................
+static int connectTcp(char const *arg) {
     char hostName[128];
     char const *serviceName = "6601";   // default QSPY server port
-    char const *src;
     char *dst;
     int status;
+    int sock = INVALID_SOCKET;
 
     struct addrinfo *result = NULL;
     struct addrinfo *rp = NULL;
     struct addrinfo hints;
-    int sockopt_bool;
 
     // extract hostName from 'arg' (hostName:port_remote)...
-    src = (arg != (void *)0)
-          ? (char const *)arg
-          : "localhost"; // default QSPY host
+    char const *src = arg;
     dst = hostName;
     while ((*src != '\0')
            && (*src != ':')
@@ -106,6 +106,9 @@ uint8_t QS_onStartup(void const *arg) {
         *dst++ = *src++;
     }
     *dst = '\0'; // zero-terminate hostName
+    if (hostName[0] == '\0') { // only the port (':serviceName')?
+        STRNCPY_S(hostName, sizeof(hostName), "localhost");
+    }
 
     // extract serviceName from 'arg' (hostName:serviceName)...
     if (*src == ':') {
@@ -121,17 +124,17 @@ uint8_t QS_onStartup(void const *arg) {
         FPRINTF_S(stderr,
             "<TARGET> ERROR   cannot resolve host Name=%s:%s,Err=%d\n",
                     hostName, serviceName, status);
-        goto error;
+        return INVALID_SOCKET;
     }
 
     for (rp = result; rp != NULL; rp = rp->ai_next) {
-        l_sock = socket(rp->ai_family, rp->ai_socktype, rp->ai_protocol);
-        if (l_sock != INVALID_SOCKET) {
-            if (connect(l_sock, rp->ai_addr, rp->ai_addrlen)
+        sock = socket(rp->ai_family, rp->ai_socktype, rp->ai_protocol);
+        if (sock != INVALID_SOCKET) {
+            if (connect(sock, rp->ai_addr, rp->ai_addrlen)
                 == SOCKET_ERROR)
             {
-                close(l_sock);
-                l_sock = INVALID_SOCKET;
+                close(sock);
+                sock = INVALID_SOCKET;
             }
             break;
         }
@@ -140,10 +143,30 @@ uint8_t QS_onStartup(void const *arg) {
     freeaddrinfo(result);
 
     // socket could not be opened & connected?
-    if (l_sock == INVALID_SOCKET) {
+    if (sock == INVALID_SOCKET) {
         FPRINTF_S(stderr, "<TARGET> ERROR   cannot connect to QSPY at "
             "host=%s:%s\n",
             hostName, serviceName);
+    }
+    return sock;
+}
+//............................................................................
+uint8_t QS_onStartup(void const *arg) {
+
+    static uint8_t qsBuf[QS_TX_SIZE];   // buffer for QS-TX channel
+    QS_initBuf(qsBuf, sizeof(qsBuf));
+
+    static uint8_t qsRxBuf[QS_RX_SIZE]; // buffer for QS-RX channel
+    QS_rxInitBuf(qsRxBuf, sizeof(qsRxBuf));
+
+    int status;
+    int sockopt_bool;
+
+    char const *src = (arg != (void *)0)
+          ? (char const *)arg
+          : "localhost"; // default QSPY host
+    l_sock = connectTcp(src); // see NOTE3
+    if (l_sock == INVALID_SOCKET) {
         goto error;
     }
 
@@ -170,6 +193,16 @@ uint8_t QS_onStartup(void const *arg) {
     sockopt_bool = 0; // negative option
     setsockopt(l_sock, SOL_SOCKET, SO_LINGER,
                &sockopt_bool, sizeof(sockopt_bool));
+
+    // send the (already chunked) QS output without the Nagle delays
+    sockopt_bool = 1;
+    setsockopt(l_sock, IPPROTO_TCP, TCP_NODELAY,
+               &sockopt_bool, sizeof(sockopt_bool));
+
+#ifdef QS_FORK_RESET
+    forkServer(); // returns only in the test process, see NOTE1
+#endif
+
     QS_onFlush();
 
     // install the SIGINT (Ctrl-C) signal handler
@@ -195,11 +228,41 @@ void QS_onCleanup(void) {
 }
 //............................................................................
 void QS_onReset(void) {
+#ifndef QS_FORK_RESET
     QS_onCleanup();
+#endif
+    // NOTE: with the fork-server, the connection to QSPY stays open in the
+    // server process, so there is no need to wait for the QS output
+    // to come out before exiting (see NOTE1)
     //PRINTF_S("\n%s\n", "QS_onReset");
     exit(0);
 }
 //............................................................................
+static bool waitWritable(void) {
+    struct pollfd pfd;
+    pfd.fd = l_sock;
+    pfd.events = POLLOUT;
+    for (;;) { // for-ever until return
+        int const status = poll(&pfd, 1U, -1);
+        if (status > 0) {
+            if ((pfd.revents & (POLLERR | POLLHUP | POLLNVAL)) != 0) {
+                FPRINTF_S(stderr, "<TARGET> ERROR   %s\n",
+                          "TCP connection to QSPY lost");
+                return false;
+            }
+            return true;
+        }
+        else if ((status < 0) && (errno != EINTR)) {
+            FPRINTF_S(stderr, "<TARGET> ERROR   socket poll,errno=%d\n",
+                      errno);
+            return false;
+        }
+        else {
+            // interrupted by a signal, keep waiting
+        }
+    }
+}
+//............................................................................
 // NOTE:
 // No critical section in QS_onFlush() to avoid nesting of critical sections
 // in case QS_onFlush() is called from Q_onError().
@@ -211,18 +274,21 @@ void QS_onFlush(void) {
         return;
     }
 
-    static struct timespec const c_timeout = { 0, QS_TIMEOUT_MS*1000000L };
-
     uint16_t nBytes = QS_TX_CHUNK;
     uint8_t const *data;
     while ((data = QS_getBlock(&nBytes)) != (uint8_t *)0) {
         for (;;) { // for-ever until break or return
             int nSent = send(l_sock, (char const *)data, (int)nBytes, 0);
             if (nSent == SOCKET_ERROR) { // sending failed?
-                if ((errno == EWOULDBLOCK) || (errno == EAGAIN)) {
-                    // sleep for the timeout and then loop back
-                    // to send() the SAME data again
-                    nanosleep(&c_timeout, NULL);
+                if ((errno == EWOULDBLOCK) || (errno == EAGAIN)
+                    || (errno == EINTR))
+                {
+                    // wait until the socket becomes writable and then
+                    // loop back to send() the SAME data again
+                    if (!waitWritable()) {
+                        QF_stop(); // <== stop and exit the application
+                        return;
+                    }
                 }
                 else { // some other socket error...
                     FPRINTF_S(stderr, "<TARGET> ERROR   sending data over TCP,"
@@ -232,8 +298,8 @@ void QS_onFlush(void) {
                 }
             }
             else if (nSent < (int)nBytes) { // sent fewer than requested?
-                nanosleep(&c_timeout, NULL); // sleep for the timeout
                 // adjust the data and loop back to send() the rest
+                // (send() will wait for the socket to become writable)
                 data   += nSent;
                 nBytes -= (uint16_t)nSent;
             }
@@ -247,28 +313,28 @@ void QS_onFlush(void) {
 }
 //............................................................................
 void QS_onTestLoop() {
-    fd_set readSet;
-    FD_ZERO(&readSet);
-
-    struct timeval timeout = {
-        (long)0, (long)(QS_TIMEOUT_MS * 1000)
-    };
+    struct pollfd pfd;
+    pfd.fd = l_sock;
+    pfd.events = POLLIN;
 
     QS_rxPriv_.inTestLoop = true;
     while (QS_rxPriv_.inTestLoop) {
-        FD_SET(l_sock, &readSet);
+        QS_onFlush(); // send all QS output before waiting, see NOTE2
 
-        // selective, timed blocking on the TCP/IP socket...
-        timeout.tv_usec = (long)(QS_TIMEOUT_MS * 1000);
-        int status = select(l_sock + 1, &readSet,
-                      (fd_set *)0, (fd_set *)0, &timeout);
+        // event-driven blocking on the TCP/IP socket...
+        int status = poll(&pfd, 1U, -1);
         if (status < 0) {
-            FPRINTF_S(stderr, "<TARGET> ERROR socket select,errno=%d\n",
+            if (errno == EINTR) { // interrupted by a signal?
+                continue;
+            }
+            FPRINTF_S(stderr, "<TARGET> ERROR socket poll,errno=%d\n",
                 errno);
             QS_onCleanup();
             exit(-2);
         }
-        else if ((status > 0) && FD_ISSET(l_sock, &readSet)) { // socket ready
+        else if ((pfd.revents & (POLLIN | POLLHUP | POLLERR | POLLNVAL))
+                 != 0)
+        {
             status = recv(l_sock,
                           (char *)QS_rxPriv_.buf, (int)QS_rxPriv_.end, 0);
             if (status > 0) { // any data received?
@@ -276,13 +342,101 @@ void QS_onTestLoop() {
                 QS_rxPriv_.head = status; // # bytes received
                 QS_rxParse(); // parse all received bytes
             }
+            else if ((status == 0) // QSPY closed the connection?
+                     || ((errno != EAGAIN) && (errno != EWOULDBLOCK)
+                         && (errno != EINTR)))
+            {
+                QS_onCleanup();
+                exit(0);
+            }
+            else {
+                // no data yet (spurious wakeup)
+            }
+        }
+        else {
+            // no events (cannot happen without the timeout)
         }
-
-        QS_onFlush();
     }
+    QS_onFlush(); // send the QS output of the last command
+
     // set inTestLoop to true in case calls to QS_onTestLoop() nest,
     // which can happen through the calls to QS_TEST_PAUSE().
     //
     QS_rxPriv_.inTestLoop = true;
 }
 
+
+#ifdef QS_FORK_RESET
+//............................................................................
+static void forkServer(void) {
+    for (;;) { // for-ever until return or exit()
+        fflush(NULL); // don't let the test process repeat buffered output
+        pid_t const pid = fork();
+        if (pid == 0) { // the forked test process?
+            return; // continue from the snapshot of the initial state
+        }
+        if (pid < 0) { // fork failed?
+            FPRINTF_S(stderr, "<TARGET> ERROR   fork-server disabled "
+                "errno=%d\n", errno);
+            return; // continue without the fork-server
+        }
+
+        int status = 0;
+        while ((waitpid(pid, &status, 0) < 0) && (errno == EINTR)) {
+        }
+
+        // not a reset, or the connection to QSPY has been closed?
+        if (!WIFEXITED(status)
+            || (WEXITSTATUS(status) != 0)
+            || !isConnected())
+        {
+            close(l_sock);
+            l_sock = INVALID_SOCKET;
+            exit(WIFEXITED(status) ? WEXITSTATUS(status) : -1);
+        }
+        // otherwise fork a new test process
+    }
+}
+//............................................................................
+static bool isConnected(void) {
+    uint8_t b;
+    ssize_t const n = recv(l_sock, &b, 1U, MSG_PEEK | MSG_DONTWAIT);
+    return (n > 0) // data pending (e.g., commands after the reset)?
+           || ((n < 0) && ((errno == EAGAIN) || (errno == EWOULDBLOCK)));
+}
+#endif // QS_FORK_RESET
+
+//============================================================================
+// NOTE1:
+// The fork-server (QS_FORK_RESET) avoids the costly restart of the test
+// process after every reset of the Target (QS_onReset()). Instead of
+// exiting, the original process becomes a server, which holds the snapshot
+// of the initial state (taken after QS_INIT(), connected to QSPY, with the
+// QS_TARGET_INFO record pending in the QS buffer). The server forks a test
+// process, which continues from the snapshot, and waits for it to exit.
+// After a reset (exit status 0 with the connection to QSPY still open) the
+// server forks a new test process, which costs only milliseconds and reuses
+// the same TCP connection to QSPY. Otherwise, the server exits with the
+// exit status of the test process.
+//
+// The state established before QS_INIT() (e.g., in QF_init()) comes from
+// the snapshot, so it is the same as in a freshly started process, except
+// for the process ID and the resources not inherited by fork() (threads).
+//
+// NOTE2:
+// The test loop is event-driven. It blocks in poll() until QSPY sends
+// data (no periodic timeout), and QS_onFlush() waits in poll() for the
+// socket to become writable (no fixed sleeps). Therefore, the latency of
+// a command (e.g., until its ACK) is bounded only by the processing time.
+// All QS output is sent before every wait for QSPY.
+//
+// NOTE3:
+// The argument of QS_onStartup() (typically argv[1] of the test fixture)
+// selects the TCP/IP connection to QSPY as "host:port" (default
+// "localhost:6601"), or as ":port" for the localhost.
+//
+// Multiple instances of test fixtures can then run in parallel (e.g., one
+// per CPU core), each connected to its own QSPY instance on distinct
+// ports (qspy -u<udp_port> -t<tcp_port>). The "parallel" target of the
+// QUTest example Makefiles launches such QSPY/fixture pairs.
+//
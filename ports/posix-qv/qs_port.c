@@ -51,6 +51,19 @@
 #include <time.h>
 #include <unistd.h>
 #include <fcntl.h>
+#ifdef QS_TX_BATCH
+#include <poll.h>
+#include <sys/uio.h>
+#endif
+#ifdef QS_TRACE_FILE
+#include <signal.h>
+#include <sys/mman.h>
+#endif
+#if (defined QS_TSC_TIME) && (defined __x86_64__)
+#define QS_TSC_X86_ // the TSC is available (if invariant)
+#include <cpuid.h>
+#include <x86intrin.h>
+#endif
 
 //Q_DEFINE_THIS_MODULE("qs_port")
 
@@ -66,9 +79,888 @@
 static int l_sock = INVALID_SOCKET;
 static struct timespec const c_timeout = { 0, QS_TIMEOUT_MS*1000000L };
 
+#ifdef QS_TRACE_FILE
+
+#ifndef QS_TRACE_DICT
+#define QS_TRACE_DICT     16384U // size of the dictionary area [bytes]
+#endif
+#define QS_TRACE_HDR_SIZE 4096U  // size of the trace file header [bytes]
+#define QS_TRACE_SYNC     16U    // # sync points in the trace file header
+
+// header of the memory-mapped trace file, see NOTE3
+// NOTE: must match the header in the qs_trace2qspy.c tool
+typedef struct {
+    char magic[8];          // "QSTRACE" + version
+    uint32_t hdrSize;       // offset of the dictionary area
+    uint32_t dictSize;      // size of the dictionary area
+    uint32_t ringSize;      // size of the ring (after the dictionaries)
+    uint32_t flags;         // 1: QS_FAST_FRAMING, 2: QS_FAST_CRC
+    uint32_t dictLen;       // # bytes of complete dictionary records
+    uint32_t nSync;         // # sync points recorded so far
+    uint64_t wrPos;         // # bytes written to the ring so far
+    uint64_t sync[QS_TRACE_SYNC]; // wrPos of some record beginnings
+} QSTraceHdr;
+
+static QSTraceHdr *l_trace;  // the mapped trace file (NULL if not used)
+static int l_traceFd = -1;
+
+// state of the record scanner (record boundaries and dictionaries)
+static struct {
+    uint32_t pos;    // # bytes of the current record scanned so far
+    uint32_t len;    // total length of the current fast record
+    uint32_t dictCur;// end of the current record in the dictionary area
+    uint8_t pre[5];  // the first bytes of the current record
+    uint8_t kind;    // QS_SCAN_HEAD_, QS_SCAN_DICT_, or QS_SCAN_OTHER_
+} l_scan;
+
+enum { QS_SCAN_HEAD_, QS_SCAN_DICT_, QS_SCAN_OTHER_ };
+
+// append 'n' bytes of the dictionary record to the dictionary area
+static void l_traceDict(uint8_t const * const p, uint32_t const n) {
+    if (l_scan.dictCur + n <= (uint32_t)QS_TRACE_DICT) {
+        memcpy((uint8_t *)l_trace + QS_TRACE_HDR_SIZE + l_scan.dictCur,
+               p, n);
+        l_scan.dictCur += n;
+    }
+    else { // no room for the record
+        l_scan.kind = QS_SCAN_OTHER_;
+    }
+}
+
+// the current record ends at the ring position 'wrPos'
+static void l_traceRecEnd(uint64_t const wrPos) {
+    QSTraceHdr * const hdr = l_trace;
+    if (l_scan.kind == QS_SCAN_DICT_) { // a complete dictionary record?
+        hdr->dictLen = l_scan.dictCur;
+    }
+    l_scan.dictCur = hdr->dictLen;
+    l_scan.pos  = 0U;
+    l_scan.kind = QS_SCAN_HEAD_;
+
+    // record a new sync point every 1/QS_TRACE_SYNC of the ring
+    uint64_t const last = hdr->sync[(hdr->nSync - 1U) % QS_TRACE_SYNC];
+    if ((wrPos - last) >= ((uint64_t)QS_TRACE_FILE / QS_TRACE_SYNC)) {
+        hdr->sync[hdr->nSync % QS_TRACE_SYNC] = wrPos;
+        ++hdr->nSync;
+    }
+}
+
+// scan the 'n' bytes at 'p' to be written at the ring position 'wrPos'
+static void l_traceScan(uint8_t const *p, size_t n, uint64_t wrPos) {
+    while (n > 0U) {
+        size_t k;
+        bool isEnd;
+        if (l_scan.kind == QS_SCAN_HEAD_) { // record ID not known yet?
+            uint8_t const b = *p;
+            l_scan.pre[l_scan.pos] = b;
+            ++l_scan.pos;
+            k = 1U;
+            int rec = -1; // record ID (if known)
+#ifndef QS_FAST_FRAMING
+            isEnd = (b == QS_FRAME); // (incomplete record)
+            if (!isEnd
+                && (l_scan.pos == ((l_scan.pre[0] == QS_ESC) ? 3U : 2U)))
+            {
+                rec = b; // the record ID follows the (escaped) seq. number
+            }
+#else
+            isEnd = false;
+            if ((l_scan.pos == 1U) && (b != QS_FAST_SYNC)) { // no sync?
+                l_scan.pos = 0U; // skip the byte to resynchronize
+            }
+            else if (l_scan.pos == 5U) { // sync, length, seq. num, and ID?
+                l_scan.len = 3U + (uint32_t)l_scan.pre[1]
+                             + ((uint32_t)l_scan.pre[2] << 8U);
+                if (l_scan.len > (3U + QS_REC_MAX)) { // corrupted length?
+                    l_scan.pos = 0U; // resynchronize at the next sync byte
+                }
+                else {
+                    rec = b;
+                    isEnd = (l_scan.len <= 5U);
+                }
+            }
+            else {
+                // more bytes of the record header needed
+            }
+#endif
+            if (rec >= 0) {
+                if ((rec == (int)QS_ENUM_DICT)
+                    || ((rec >= (int)QS_SIG_DICT)
+                        && (rec <= (int)QS_TARGET_INFO))
+                    || (rec == (int)QS_TIME_INFO))
+                {
+                    l_scan.kind = QS_SCAN_DICT_;
+                    l_traceDict(l_scan.pre, l_scan.pos);
+                }
+                else {
+                    l_scan.kind = QS_SCAN_OTHER_;
+                }
+            }
+        }
+        else { // the rest of the record
+#ifndef QS_FAST_FRAMING
+            uint8_t const *f = (uint8_t const *)memchr(p, QS_FRAME, n);
+            isEnd = (f != (uint8_t const *)0);
+            k = isEnd ? (size_t)(f - p) + 1U : n;
+#else
+            k = l_scan.len - l_scan.pos;
+            isEnd = (k <= n);
+            if (!isEnd) {
+                k = n;
+            }
+#endif
+            if (l_scan.kind == QS_SCAN_DICT_) {
+                l_traceDict(p, (uint32_t)k);
+            }
+            l_scan.pos += (uint32_t)k;
+        }
+        p += k;
+        n -= k;
+        wrPos += k;
+        if (isEnd) {
+            l_traceRecEnd(wrPos);
+        }
+    }
+}
+
+// write 'n' bytes of the QS output to the ring of the trace file
+static void l_traceWrite(uint8_t const *p, size_t n) {
+    QSTraceHdr * const hdr = l_trace;
+    uint8_t * const ring = (uint8_t *)hdr + QS_TRACE_HDR_SIZE + QS_TRACE_DICT;
+    uint64_t wrPos = hdr->wrPos;
+
+    l_traceScan(p, n, wrPos);
+    while (n > 0U) {
+        size_t const pos = (size_t)(wrPos % (uint64_t)QS_TRACE_FILE);
+        size_t k = (size_t)QS_TRACE_FILE - pos;
+        if (k > n) {
+            k = n;
+        }
+        memcpy(&ring[pos], p, k);
+        p += k;
+        n -= k;
+        wrPos += k;
+    }
+    __atomic_store_n(&hdr->wrPos, wrPos, __ATOMIC_RELEASE);
+}
+
+// copy all data from the QS buffer to the trace file
+static void l_traceCopy(void) {
+    uint16_t nBytes = QS_TX_CHUNK;
+    uint8_t const *data;
+    while ((data = QS_getBlock(&nBytes)) != (uint8_t *)0) {
+        l_traceWrite(data, nBytes);
+        nBytes = QS_TX_CHUNK; // for the next call to QS_getBlock()
+    }
+}
+
+// save the QS data before the process terminates on a fatal signal
+static void l_traceCrash(int sig) {
+    if (l_trace != (QSTraceHdr *)0) {
+        l_traceCopy();
+    }
+    raise(sig); // the default action (SA_RESETHAND)
+}
+
+// create and map the trace file 'path'
+static bool l_traceOpen(char const * const path) {
+    size_t const size = (size_t)QS_TRACE_HDR_SIZE + QS_TRACE_DICT
+                        + (size_t)QS_TRACE_FILE;
+    l_traceFd = open(path, O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (l_traceFd < 0) {
+        FPRINTF_S(stderr, "<TARGET> ERROR   cannot open trace file %s,"
+                  "errno=%d\n", path, errno);
+        return false;
+    }
+    void *map = MAP_FAILED;
+    if (ftruncate(l_traceFd, (off_t)size) == 0) {
+        map = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED,
+                   l_traceFd, 0);
+    }
+    if (map == MAP_FAILED) {
+        FPRINTF_S(stderr, "<TARGET> ERROR   cannot map trace file %s,"
+                  "errno=%d\n", path, errno);
+        close(l_traceFd);
+        l_traceFd = -1;
+        return false;
+    }
+
+    QSTraceHdr * const hdr = (QSTraceHdr *)map;
+    memcpy(hdr->magic, "QSTRACE1", sizeof(hdr->magic));
+    hdr->hdrSize  = QS_TRACE_HDR_SIZE;
+    hdr->dictSize = QS_TRACE_DICT;
+    hdr->ringSize = QS_TRACE_FILE;
+#ifdef QS_FAST_FRAMING
+    hdr->flags = 1U;
+#ifdef QS_FAST_CRC
+    hdr->flags |= 2U;
+#endif
+#endif
+    hdr->nSync = 1U; // sync point at the beginning of the ring (0)
+    l_scan.kind = QS_SCAN_HEAD_;
+    l_trace = hdr;
+
+    // save the QS data on the fatal signals, see NOTE3
+    struct sigaction sig_act;
+    memset(&sig_act, 0, sizeof(sig_act));
+    sig_act.sa_handler = &l_traceCrash;
+    sig_act.sa_flags = SA_RESETHAND;
+    sigaction(SIGSEGV, &sig_act, NULL);
+    sigaction(SIGBUS,  &sig_act, NULL);
+    sigaction(SIGFPE,  &sig_act, NULL);
+    sigaction(SIGILL,  &sig_act, NULL);
+    sigaction(SIGABRT, &sig_act, NULL);
+
+    return true;
+}
+
+// copy the rest of the QS data and unmap the trace file
+static void l_traceClose(void) {
+    QSTraceHdr * const hdr = l_trace;
+    l_traceCopy();
+    l_trace = (QSTraceHdr *)0;
+    munmap(hdr, (size_t)QS_TRACE_HDR_SIZE + QS_TRACE_DICT
+                + (size_t)QS_TRACE_FILE);
+    close(l_traceFd);
+    l_traceFd = -1;
+}
+
+#define QS_TRACE_ON_() (l_trace != (QSTraceHdr *)0)
+
+#else
+
+#define QS_TRACE_ON_() false
+
+#endif // def QS_TRACE_FILE
+
+#ifdef QS_TSC_TIME
+// time-stamp counter (TSC) as the source of QS time stamps, see NOTE4
+static struct {
+    uint64_t base;  // TSC at the end of calibration
+    uint64_t time0; // QS time [100ns] at the end of calibration
+    uint64_t mult;  // 100ns units per TSC tick (32.32 fixed-point), 0: none
+    uint32_t kHz;   // calibrated TSC frequency [kHz]
+} l_tsc;
+
+// calibrate the invariant TSC against CLOCK_MONOTONIC_RAW
+static void l_tscCalibrate(void) {
+#ifdef QS_TSC_X86_
+    unsigned a;
+    unsigned b;
+    unsigned c;
+    unsigned d;
+    if ((__get_cpuid(0x80000007U, &a, &b, &c, &d) == 0)
+        || ((d & (1U << 8U)) == 0U)) // no invariant TSC?
+    {
+        return; // keep using clock_gettime()
+    }
+
+    static struct timespec const c_calib = { 0, 20L*1000000L }; // 20ms
+    struct timespec t0;
+    struct timespec t1;
+    clock_gettime(CLOCK_MONOTONIC_RAW, &t0);
+    uint64_t const tsc0 = __rdtsc();
+    nanosleep(&c_calib, NULL);
+    clock_gettime(CLOCK_MONOTONIC_RAW, &t1);
+    uint64_t const tsc1 = __rdtsc();
+
+    uint64_t const ns = ((uint64_t)(t1.tv_sec - t0.tv_sec) * 1000000000U)
+                        + (uint64_t)t1.tv_nsec - (uint64_t)t0.tv_nsec;
+    if ((ns == 0U) || (tsc1 <= tsc0)) {
+        return; // calibration failed, keep using clock_gettime()
+    }
+    uint64_t const hz = ((tsc1 - tsc0) * 1000000000U) / ns;
+    if (hz <= 10000000U) { // TSC slower than the 100ns time units?
+        return; // keep using clock_gettime()
+    }
+    l_tsc.kHz   = (uint32_t)(hz / 1000U);
+    l_tsc.base  = tsc1;
+    l_tsc.time0 = ((uint64_t)t1.tv_sec * 10000000U)
+                  + ((uint64_t)t1.tv_nsec / 100U);
+    l_tsc.mult  = ((uint64_t)10000000U << 32U) / hz;
+#endif // def QS_TSC_X86_
+}
+
+//............................................................................
+void QS_timeInfo_(void) {
+    // NOTE: called right after QS_TARGET_INFO (in a critical section)
+
+    QS_beginRec_((uint_fast8_t)QS_TIME_INFO);
+        QS_U8_PRE_((l_tsc.mult != 0U) ? 1U : 0U); // 1: TSC, 0: clock
+        QS_U32_PRE_(10000000U); // QS time-stamp units per second
+        QS_U32_PRE_(l_tsc.kHz); // TSC frequency [kHz] (0: TSC not used)
+    QS_endRec_();
+}
+#endif // def QS_TSC_TIME
+
+#if (defined QS_TX_BATCH) || (defined QS_THREAD_BUF)
+// join the 'thread' if it finishes (sets '*done') within 'ms' milliseconds,
+// otherwise detach it (e.g., it waits for the QF mutex held by the caller)
+static bool l_joinWithin(pthread_t const thread,
+                         bool volatile const * const done, int const ms)
+{
+    static struct timespec const c_1ms = { 0, 1000000L };
+    for (int i = 0; (i < ms) && !*done; ++i) {
+        nanosleep(&c_1ms, NULL);
+    }
+    bool const joined = *done;
+    if (joined) {
+        pthread_join(thread, NULL);
+    }
+    else {
+        pthread_detach(thread);
+    }
+    return joined;
+}
+#endif
+
+#ifdef QS_TX_BATCH
+
+#ifndef QS_TX_LATENCY
+#define QS_TX_LATENCY  10000U
+#endif
+
+static pthread_t l_txThread;
+static pthread_mutex_t l_txMutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t l_txCond;     // TX thread wakeup (CLOCK_MONOTONIC)
+static bool l_txFlush;              // send all now? (guarded by l_txMutex)
+static bool volatile l_txRun;       // TX thread running?
+static bool volatile l_txDone;      // TX thread finished?
+static bool volatile l_txSending;   // TX thread sending the data?
+static uint8_t l_txBuf[QS_TX_CHUNK]; // data being sent by the TX thread
+
+// wake up the TX thread, and request sending all data if 'flush'
+static void l_txWake(bool const flush) {
+    pthread_mutex_lock(&l_txMutex);
+    if (flush) {
+        l_txFlush = true;
+    }
+    pthread_cond_signal(&l_txCond);
+    pthread_mutex_unlock(&l_txMutex);
+}
+
+// send all 'cnt' segments in 'iov', returns false on a socket error
+static bool l_txWritev(struct iovec *iov, int cnt) {
+#ifdef QS_TRACE_FILE
+    if (QS_TRACE_ON_()) { // writing to the trace file?
+        for (int i = 0; i < cnt; ++i) {
+            l_traceWrite((uint8_t const *)iov[i].iov_base, iov[i].iov_len);
+        }
+        return true;
+    }
+#endif
+    while (cnt > 0) {
+        ssize_t nSent = writev(l_sock, iov, cnt);
+        if (nSent < 0) { // sending failed?
+            if ((errno == EWOULDBLOCK) || (errno == EAGAIN)) {
+                // wait (in this thread only) for room in the socket
+                struct pollfd pfd = { l_sock, POLLOUT, 0 };
+                (void)poll(&pfd, 1, (int)QS_TIMEOUT_MS);
+            }
+            else if (errno != EINTR) { // some other socket error...
+                FPRINTF_S(stderr, "<TARGET> ERROR   sending data over TCP,"
+                       "errno=%d\n", errno);
+                return false;
+            }
+            else {
+                // interrupted by a signal, try again
+            }
+        }
+        else { // skip the segments (and bytes) sent so far
+            while ((cnt > 0) && ((size_t)nSent >= iov[0].iov_len)) {
+                nSent -= (ssize_t)iov[0].iov_len;
+                ++iov;
+                --cnt;
+            }
+            if (cnt > 0) {
+                iov[0].iov_base = (uint8_t *)iov[0].iov_base + nSent;
+                iov[0].iov_len -= (size_t)nSent;
+            }
+        }
+    }
+    return true;
+}
+
+// send all data from the QS buffer, returns false on a socket error
+static bool l_txSend(void) {
+    for (;;) { // for-ever until the QS buffer is empty
+        // copy the data out of the QS buffer, which the producers can
+        // reuse as soon as the critical section is left, see NOTE2
+        QS_CRIT_STAT
+        QS_CRIT_ENTRY();
+        uint16_t len = QS_TX_CHUNK;
+        uint8_t const *data = QS_getBlock(&len);
+        if (data != (uint8_t *)0) {
+            memcpy(&l_txBuf[0], data, len);
+
+            // the data wraps around the end of the ring buffer?
+            uint16_t n = (uint16_t)(QS_TX_CHUNK - len);
+            data = (n > 0U) ? QS_getBlock(&n) : (uint8_t *)0;
+            if (data != (uint8_t *)0) {
+                memcpy(&l_txBuf[len], data, n);
+                len = (uint16_t)(len + n);
+            }
+        }
+        else {
+            len = 0U;
+        }
+        l_txSending = (len > 0U);
+        QS_CRIT_EXIT();
+
+        if (len == 0U) { // no more data?
+            return true;
+        }
+        struct iovec iov[1];
+        iov[0].iov_base = (void *)&l_txBuf[0];
+        iov[0].iov_len  = len;
+        bool const ok = l_txWritev(iov, 1);
+        l_txSending = false;
+        if (!ok) {
+            return false;
+        }
+    }
+}
+
+// the QS transmit thread, see NOTE2
+static void *l_txLoop(void *arg);
+
+// start the QS transmit thread
+static bool l_txStart(void) {
+    pthread_condattr_t cattr;
+    pthread_condattr_init(&cattr);
+    pthread_condattr_setclock(&cattr, CLOCK_MONOTONIC);
+    pthread_cond_init(&l_txCond, &cattr);
+    pthread_condattr_destroy(&cattr);
+    l_txRun = true;
+    if (pthread_create(&l_txThread, NULL, &l_txLoop, NULL) != 0) {
+        l_txRun = false;
+    }
+    return l_txRun;
+}
+
+static void *l_txLoop(void *arg) {
+    (void)arg;
+    bool run = true;
+    while (run) {
+        pthread_mutex_lock(&l_txMutex);
+
+        struct timespec deadline;
+        clock_gettime(CLOCK_MONOTONIC, &deadline);
+        long const nsec = deadline.tv_nsec + ((long)QS_TX_LATENCY * 1000L);
+        deadline.tv_sec += (time_t)(nsec / 1000000000L);
+        deadline.tv_nsec = nsec % 1000000000L;
+
+        // wait for a full batch, the latency, or a flush request
+        while (l_txRun && !l_txFlush
+               && (QS_priv_.used < (QSCtr)QS_TX_BATCH))
+        {
+            if (pthread_cond_timedwait(&l_txCond, &l_txMutex, &deadline)
+                == ETIMEDOUT)
+            {
+                break;
+            }
+        }
+        run = l_txRun;
+        l_txFlush = false;
+        pthread_mutex_unlock(&l_txMutex);
+
+        if (!l_txSend()) { // socket error?
+            QF_stop(); // <== stop and exit the application
+            run = false;
+        }
+    }
+    l_txDone = true;
+    return (void *)0;
+}
+
+#endif // def QS_TX_BATCH
+
+#ifdef QS_THREAD_BUF
+
+#define QS_THREAD_MAX      (QF_MAX_ACTIVE + 2U)
+#define QS_THREAD_REC_MAX  1024U
+
+#if (defined QS_REC_MAX) && (QS_REC_MAX > QS_THREAD_REC_MAX)
+#error QS_REC_MAX must not exceed QS_THREAD_REC_MAX
+#endif
+#define QS_THREAD_STAMP_   ((QSCtr)sizeof(QSTimeCtr)) // see NOTE1
+
+// per-thread trace buffer, see NOTE1
+typedef struct {
+    QS_Attr tx;               // QS-TX state of the owner (must be first)
+    QSCtr volatile ready;     // end of the last complete record
+    QSCtr volatile tail;      // beginning of the records not merged yet
+    uint32_t volatile nLost;  // # records lost because of a full buffer
+    uint8_t sto[QS_THREAD_BUF];      // ring buffer of complete records
+    uint8_t sink[QS_THREAD_REC_MAX]; // scratch space for a lost record
+} QSThreadBuf;
+
+static QSThreadBuf l_thrBuf[QS_THREAD_MAX];
+static uint_fast8_t volatile l_thrNum; // # per-thread buffers in use
+static pthread_t l_drainThread;
+static bool volatile l_drainRun;
+static bool volatile l_drainDone;
+static bool volatile l_drainPend; // records published since the last drain
+static pthread_mutex_t l_drainMutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t  l_drainCond  = PTHREAD_COND_INITIALIZER;
+
+_Thread_local QS_Attr *QS_tx_ = &QS_priv_;
+
+#ifndef QS_FAST_FRAMING
+
+#define QS_FRAME_END_ 0x100U // raw QS_FRAME returned from l_getByte()
+
+// get the next unescaped byte from the per-thread buffer 'tb'
+static uint16_t l_getByte(QSThreadBuf const * const tb, QSCtr * const pos) {
+    QSCtr p = *pos;
+    uint16_t b = tb->sto[p];
+    if (++p == (QSCtr)QS_THREAD_BUF) {
+        p = 0U;
+    }
+    if (b == QS_FRAME) {
+        b = QS_FRAME_END_;
+    }
+    else if (b == QS_ESC) {
+        b = (uint16_t)(tb->sto[p] ^ QS_ESC_XOR);
+        if (++p == (QSCtr)QS_THREAD_BUF) {
+            p = 0U;
+        }
+    }
+    else {
+        // regular byte
+    }
+    *pos = p;
+    return b;
+}
+
+// insert the byte 'b_' into the shared QS buffer (with escaping)
+#define QS_PUT_ESC_(b_)                              \
+    if (((b_) != QS_FRAME) && ((b_) != QS_ESC)) {    \
+        QS_INSERT_BYTE_(b_)                          \
+        ++n;                                         \
+    }                                                \
+    else {                                           \
+        QS_INSERT_BYTE_(QS_ESC)                      \
+        QS_INSERT_BYTE_((uint8_t)((b_) ^ QS_ESC_XOR))\
+        n += 2U;                                     \
+    }
+
+#else // QS_FAST_FRAMING
+
+// get the next byte from the per-thread buffer 'tb'
+static uint8_t l_getByte(QSThreadBuf const * const tb, QSCtr * const pos) {
+    QSCtr p = *pos;
+    uint8_t const b = tb->sto[p];
+    if (++p == (QSCtr)QS_THREAD_BUF) {
+        p = 0U;
+    }
+    *pos = p;
+    return b;
+}
+
+#endif // QS_FAST_FRAMING
+
+// the time stamp of the record at 'pos' in the per-thread buffer 'tb'
+static QSTimeCtr l_getStamp(QSThreadBuf const * const tb, QSCtr pos) {
+    QSTimeCtr t = 0U;
+    for (QSCtr i = 0U; i < QS_THREAD_STAMP_; ++i) {
+        t |= (QSTimeCtr)((QSTimeCtr)tb->sto[pos] << (8U * i));
+        if (++pos == (QSCtr)QS_THREAD_BUF) {
+            pos = 0U;
+        }
+    }
+    return t;
+}
+
+// merge the record at 'pos' in 'tb' into the shared QS buffer
+// (in a critical section), returns the # bytes inserted
+static QSCtr l_mergeRec(QSThreadBuf const * const tb, QSCtr * const pos) {
+    QSCtr n = 0U; // # bytes inserted into the shared QS buffer
+    uint8_t * const buf = QS_priv_.buf;
+    QSCtr head          = QS_priv_.head;
+    QSCtr const end     = QS_priv_.end;
+
+    QSCtr tail = *pos + QS_THREAD_STAMP_; // skip the time stamp
+    if (tail >= (QSCtr)QS_THREAD_BUF) {
+        tail -= (QSCtr)QS_THREAD_BUF;
+    }
+
+    do { // for a single record, so that 'break' drops it
+#ifdef QS_FAST_FRAMING
+        // the fast record: sync byte, 2-byte length, sequence number,
+        // and the rest
+        (void)l_getByte(tb, &tail); // skip the sync byte
+        uint16_t len = l_getByte(tb, &tail);
+        len |= (uint16_t)((uint16_t)l_getByte(tb, &tail) << 8U);
+        (void)l_getByte(tb, &tail); // skip the old sequence number
+
+        // no room for the record in the QS buffer? (drop the newest)
+        // NOTE: the record is not longer than QS_REC_MAX (see QS_endRec_()),
+        // but the exact length is checked as well to never overwrite
+        // the oldest data in the QS buffer
+        if (((QS_priv_.used + n + QS_REC_MAX) > end)
+            || ((QS_priv_.used + n + (QSCtr)len + 3U) > end))
+        {
+            QS_dropRec_(l_getByte(tb, &tail));
+            for (uint16_t i = 2U; i < len; ++i) {
+                (void)l_getByte(tb, &tail); // skip the record data
+            }
+            break;
+        }
+
+        // re-number the record in the sequence of the shared QS buffer
+        // (the CRC does not cover the sequence number)
+        uint8_t const seq = (uint8_t)(QS_priv_.seq + 1U);
+        QS_priv_.seq = seq;
+        QS_INSERT_BYTE_((uint8_t)QS_FAST_SYNC)
+        QS_INSERT_BYTE_((uint8_t)len)
+        QS_INSERT_BYTE_((uint8_t)(len >> 8U))
+        QS_INSERT_BYTE_(seq)
+        for (uint16_t i = 1U; i < len; ++i) {
+            QS_INSERT_BYTE_(l_getByte(tb, &tail))
+        }
+        n += (QSCtr)len + 3U;
+#else // classic QS framing
+#if (defined QS_OVERFLOW_POLICY) && (QS_OVERFLOW_POLICY != 0U)
+        // no room for the record in the QS buffer? (drop the newest)
+        // NOTE: the record is not longer than QS_REC_MAX (see QS_endRec_()),
+        // but the re-numbered record can grow by 2 bytes, when the new
+        // sequence number and the checksum need escaping
+        if ((QS_priv_.used + n + QS_REC_MAX + 2U) > end) {
+            (void)l_getByte(tb, &tail); // skip the sequence number
+            uint16_t const rec = l_getByte(tb, &tail);
+            while (l_getByte(tb, &tail) != QS_FRAME_END_) {
+                // skip the record data
+            }
+            QS_dropRec_((uint8_t)rec);
+            break;
+        }
+#endif
+        // re-number the record in the sequence of the shared QS buffer
+        // and correct the checksum accordingly
+        uint8_t const seq = (uint8_t)(QS_priv_.seq + 1U);
+        QS_priv_.seq = seq;
+        uint8_t const delta = (uint8_t)(l_getByte(tb, &tail) - seq);
+        QS_PUT_ESC_(seq)
+
+        // copy the record ID and data, the last byte is the checksum
+        uint16_t prev = l_getByte(tb, &tail);
+        for (uint16_t b = l_getByte(tb, &tail);
+             b != QS_FRAME_END_;
+             b = l_getByte(tb, &tail))
+        {
+            QS_PUT_ESC_((uint8_t)prev)
+            prev = b;
+        }
+        uint8_t const chksum = (uint8_t)(prev + delta);
+        QS_PUT_ESC_(chksum)
+        QS_INSERT_BYTE_(QS_FRAME)
+        ++n;
+#endif // QS_FAST_FRAMING
+    } while (false);
+
+    QS_priv_.head = head;
+    QS_priv_.used += n;
+    if (QS_priv_.used > end) { // overrun over the old data?
+#ifdef QS_OVERFLOW_POLICY
+        QS_overrun_(QS_priv_.used - end);
+#endif
+        QS_priv_.used = end;   // the whole buffer is used
+        QS_priv_.tail = head;  // shift the tail to the old data
+    }
+    *pos = tail;
+
+    return n;
+}
+
+// merge the complete records of all per-thread buffers into the shared
+// QS buffer in the order of their time stamps (k-way merge), see NOTE1
+static QSCtr l_drain(void) {
+    uint_fast8_t const num = __atomic_load_n(&l_thrNum, __ATOMIC_ACQUIRE);
+    QSCtr ready[QS_THREAD_MAX];
+    QSCtr tail[QS_THREAD_MAX];
+    for (uint_fast8_t i = 0U; i < num; ++i) {
+        ready[i] = __atomic_load_n(&l_thrBuf[i].ready, __ATOMIC_ACQUIRE);
+        tail[i]  = l_thrBuf[i].tail;
+    }
+
+    QSCtr n = 0U; // # bytes inserted into the shared QS buffer
+
+    QF_CRIT_STAT
+    QF_CRIT_ENTRY();
+    for (;;) {
+        // find the buffer with the oldest record not merged yet
+        uint_fast8_t k = QS_THREAD_MAX;
+        QSTimeCtr oldest = 0U;
+        for (uint_fast8_t i = 0U; i < num; ++i) {
+            if (tail[i] != ready[i]) { // any complete records?
+                QSTimeCtr const t = l_getStamp(&l_thrBuf[i], tail[i]);
+                // older time stamp (modulo the wrap-around)?
+                if ((k == QS_THREAD_MAX)
+                    || ((QSTimeCtr)(t - oldest)
+                        > (QSTimeCtr)((QSTimeCtr)~0U >> 1U)))
+                {
+                    k = i;
+                    oldest = t;
+                }
+            }
+        }
+        if (k == QS_THREAD_MAX) { // all records merged?
+            break;
+        }
+        n += l_mergeRec(&l_thrBuf[k], &tail[k]);
+    }
+    QF_CRIT_EXIT();
+
+    for (uint_fast8_t i = 0U; i < num; ++i) { // free the merged space
+        __atomic_store_n(&l_thrBuf[i].tail, tail[i], __ATOMIC_RELEASE);
+    }
+    return n;
+}
+
+// wake up the drain thread (at most once per drain cycle), see NOTE1
+static void l_drainWake(void) {
+    // NOTE: the published 'ready' position must be visible to the drain
+    // thread before it can see 'l_drainPend' cleared and go to sleep
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    if (!__atomic_load_n(&l_drainPend, __ATOMIC_RELAXED)
+        && !__atomic_exchange_n(&l_drainPend, true, __ATOMIC_ACQ_REL))
+    {
+        pthread_mutex_lock(&l_drainMutex);
+        pthread_cond_signal(&l_drainCond);
+        pthread_mutex_unlock(&l_drainMutex);
+    }
+}
+
+static void *l_drainLoop(void *arg) {
+    (void)arg;
+    while (l_drainRun) {
+        // the records published from now on wake up the next cycle
+        __atomic_store_n(&l_drainPend, false, __ATOMIC_RELAXED);
+        __atomic_thread_fence(__ATOMIC_SEQ_CST);
+
+        if (l_drain() == 0U) { // nothing to merge?
+            pthread_mutex_lock(&l_drainMutex);
+            while (l_drainRun
+                   && !__atomic_load_n(&l_drainPend, __ATOMIC_ACQUIRE))
+            {
+                pthread_cond_wait(&l_drainCond, &l_drainMutex);
+            }
+            pthread_mutex_unlock(&l_drainMutex);
+        }
+#ifdef QS_TX_BATCH
+        else if (QS_priv_.used >= (QSCtr)QS_TX_BATCH) { // full batch?
+            l_txWake(false);
+        }
+#endif
+        else {
+            // continue merging
+        }
+    }
+    l_drain(); // merge the last records
+    l_drainDone = true;
+    return (void *)0;
+}
+
+//............................................................................
+void QS_threadAttach(void) {
+    QF_CRIT_STAT
+    QF_CRIT_ENTRY();
+    uint_fast8_t const num = l_thrNum;
+    // the calling thread has no buffer yet and a buffer is available?
+    if ((QS_tx_ == &QS_priv_) && (num < QS_THREAD_MAX)) {
+        QSThreadBuf * const tb = &l_thrBuf[num];
+        tb->tx.buf   = &tb->sto[0];
+        tb->tx.end   = (QSCtr)QS_THREAD_BUF;
+        tb->tx.head  = 0U;
+        tb->ready    = 0U;
+        tb->tail     = 0U;
+        tb->nLost    = 0U;
+        __atomic_store_n(&l_thrNum, num + 1U, __ATOMIC_RELEASE);
+        QS_tx_ = &tb->tx;
+    }
+    // otherwise the thread keeps using the shared QS buffer
+    QF_CRIT_EXIT();
+}
+//............................................................................
+uint32_t QS_getThreadLost(void) {
+    uint32_t n = 0U;
+    uint_fast8_t const num = __atomic_load_n(&l_thrNum, __ATOMIC_ACQUIRE);
+    for (uint_fast8_t i = 0U; i < num; ++i) {
+        n += l_thrBuf[i].nLost;
+    }
+    return n;
+}
+//............................................................................
+void QS_critEntry_(void) {
+    if (QS_tx_ == &QS_priv_) { // the shared QS buffer?
+        QF_CRIT_ENTRY();
+    }
+}
+//............................................................................
+void QS_critExit_(void) {
+    if (QS_tx_ == &QS_priv_) { // the shared QS buffer?
+        QF_CRIT_EXIT();
+    }
+}
+//............................................................................
+void QS_txBegin_(void) {
+    if (QS_tx_ != &QS_priv_) { // own trace buffer?
+        QSThreadBuf * const tb = (QSThreadBuf *)QS_tx_;
+        QSCtr const tail = __atomic_load_n(&tb->tail, __ATOMIC_ACQUIRE);
+        QSCtr const used = (tb->ready >= tail)
+            ? (QSCtr)(tb->ready - tail)
+            : (QSCtr)(((QSCtr)QS_THREAD_BUF - tail) + tb->ready);
+
+        // full? (the record and its time stamp must fit)
+        if (((QSCtr)QS_THREAD_BUF - used)
+            <= (QS_THREAD_REC_MAX + QS_THREAD_STAMP_))
+        {
+            tb->tx.buf  = &tb->sink[0]; // produce the record into the sink
+            tb->tx.end  = (QSCtr)QS_THREAD_REC_MAX;
+            tb->tx.head = 0U;
+        }
+        else { // time stamp for merging the records, see NOTE1
+            QSTimeCtr const t = QS_onGetTime();
+            QSCtr head = tb->tx.head;
+            for (QSCtr i = 0U; i < QS_THREAD_STAMP_; ++i) {
+                tb->sto[head] = (uint8_t)(t >> (8U * i));
+                if (++head == (QSCtr)QS_THREAD_BUF) {
+                    head = 0U;
+                }
+            }
+            tb->tx.head = head;
+        }
+        tb->tx.used = 0U;
+    }
+}
+//............................................................................
+void QS_txEnd_(void) {
+    if (QS_tx_ != &QS_priv_) { // own trace buffer?
+        QSThreadBuf * const tb = (QSThreadBuf *)QS_tx_;
+        if (tb->tx.buf == &tb->sto[0]) {
+            // publish the complete record to the drain thread
+            __atomic_store_n(&tb->ready, tb->tx.head, __ATOMIC_RELEASE);
+            l_drainWake();
+        }
+        else { // the record went to the sink
+            ++tb->nLost;
+            tb->tx.buf  = &tb->sto[0];
+            tb->tx.end  = (QSCtr)QS_THREAD_BUF;
+            tb->tx.head = tb->ready;
+        }
+    }
+}
+
+#endif // def QS_THREAD_BUF
+
 //............................................................................
 uint8_t QS_onStartup(void const *arg) {
 
+#ifdef QS_TSC_TIME
+    l_tscCalibrate(); // before QS_TIME_INFO is produced in QS_initBuf()
+#endif
+
     static uint8_t qsBuf[QS_TX_SIZE];   // buffer for QS-TX channel
     QS_initBuf(qsBuf, sizeof(qsBuf));
 
@@ -86,6 +978,18 @@ uint8_t QS_onStartup(void const *arg) {
     struct addrinfo hints;
     int sockopt_bool;
 
+#ifdef QS_TRACE_FILE
+    // the trace file instead of QSPY? ('arg' is "file:<path>")
+    if ((arg != (void *)0)
+        && (strncmp((char const *)arg, "file:", 5U) == 0))
+    {
+        if (!l_traceOpen(&((char const *)arg)[5])) {
+            goto error;
+        }
+        goto threads; // no connection to QSPY
+    }
+#endif
+
     // extract hostName from 'arg' (hostName:port_remote)...
     src = (arg != (void *)0)
           ? (char const *)arg
@@ -98,6 +1002,9 @@ uint8_t QS_onStartup(void const *arg) {
         *dst++ = *src++;
     }
     *dst = '\0'; // zero-terminate hostName
+    if (hostName[0] == '\0') { // only the port (':serviceName')?
+        STRNCPY_S(hostName, sizeof(hostName), "localhost");
+    }
 
     // extract serviceName from 'arg' (hostName:serviceName)...
     if (*src == ':') {
@@ -162,6 +1069,32 @@ uint8_t QS_onStartup(void const *arg) {
     sockopt_bool = 0; // negative option
     setsockopt(l_sock, SOL_SOCKET, SO_LINGER,
                &sockopt_bool, sizeof(sockopt_bool));
+
+#ifdef QS_TRACE_FILE
+threads: // start the QS threads (if configured)
+#endif
+#ifdef QS_TX_BATCH
+    // start the thread sending the QS output, see NOTE2
+    if (!l_txStart()) {
+        FPRINTF_S(stderr, "<TARGET> ERROR   %s\n",
+                  "cannot start the QS output thread");
+        QS_EXIT();
+        goto error;
+    }
+#endif
+
+#ifdef QS_THREAD_BUF
+    // start the thread merging the per-thread trace buffers, see NOTE1
+    l_drainRun = true;
+    if (pthread_create(&l_drainThread, NULL, &l_drainLoop, NULL) != 0) {
+        l_drainRun = false;
+        FPRINTF_S(stderr, "<TARGET> ERROR   %s\n",
+                  "cannot start the QS drain thread");
+        QS_EXIT();
+        goto error;
+    }
+#endif
+
     QS_onFlush();
 
     return 1U; // success
@@ -172,6 +1105,41 @@ error:
 //............................................................................
 void QS_onCleanup(void) {
     static struct timespec const c_timeout = {0, 10L*QS_TIMEOUT_MS*1000000L };
+#ifdef QS_THREAD_BUF
+    if (l_drainRun) { // the drain thread running?
+        pthread_mutex_lock(&l_drainMutex);
+        l_drainRun = false;
+        pthread_cond_signal(&l_drainCond);
+        pthread_mutex_unlock(&l_drainMutex);
+        (void)l_joinWithin(l_drainThread, &l_drainDone, 100);
+    }
+#endif
+#ifdef QS_TX_BATCH
+    if (l_txRun) { // the TX thread running?
+        pthread_mutex_lock(&l_txMutex);
+        l_txRun = false;
+        pthread_cond_signal(&l_txCond);
+        pthread_mutex_unlock(&l_txMutex);
+
+        // the TX thread sends the rest of the data before it finishes
+        if (!l_joinWithin(l_txThread, &l_txDone, 100)) {
+            if (!l_txSending) { // TX thread blocked on the QF mutex?
+                QS_onFlush(); // send the rest in this thread
+            }
+        }
+    }
+#endif
+#ifdef QS_TRACE_FILE
+    if (QS_TRACE_ON_()) { // writing to the trace file?
+#ifdef QS_TX_BATCH
+        if (l_txSending) { // TX thread still writing to the trace file?
+            return; // the kernel persists the mapped file anyway
+        }
+#endif
+        l_traceClose(); // no need to wait for the last QS output
+        return;
+    }
+#endif
     nanosleep(&c_timeout, NULL); // allow the last QS output to come out
     if (l_sock != INVALID_SOCKET) {
         close(l_sock);
@@ -190,12 +1158,30 @@ void QS_onReset(void) {
 // No critical section in QS_onFlush() to avoid nesting of critical sections
 // in case QS_onFlush() is called from Q_onError().
 void QS_onFlush(void) {
+#ifdef QS_TRACE_FILE
+    if (QS_TRACE_ON_()) { // writing to the trace file?
+#ifdef QS_TX_BATCH
+        if (l_txRun) { // the TX thread running?
+            l_txWake(true); // let the TX thread write all data
+            return;
+        }
+#endif
+        l_traceCopy();
+        return;
+    }
+#endif
     if (l_sock == INVALID_SOCKET) { // socket NOT initialized?
         FPRINTF_S(stderr, "<TARGET> ERROR   %s\n",
                   "invalid TCP socket");
         QF_stop(); // <== stop and exit the application
         return;
     }
+#ifdef QS_TX_BATCH
+    if (l_txRun) { // the TX thread running?
+        l_txWake(true); // let the TX thread send all data, see NOTE2
+        return;
+    }
+#endif
 
     uint16_t nBytes = QS_TX_CHUNK;
     uint8_t const *data;
@@ -231,6 +1217,15 @@ void QS_onFlush(void) {
 }
 //............................................................................
 QSTimeCtr QS_onGetTime(void) {
+#ifdef QS_TSC_X86_
+    if (l_tsc.mult != 0U) { // TSC calibrated?
+        // (dt * mult) >> 32 without overflow (mult < 2^32)
+        uint64_t const dt = __rdtsc() - l_tsc.base;
+        return (QSTimeCtr)(l_tsc.time0
+            + ((dt >> 32U) * l_tsc.mult)
+            + (((dt & 0xFFFFFFFFU) * l_tsc.mult) >> 32U));
+    }
+#endif
     struct timespec tspec;
     clock_gettime(CLOCK_MONOTONIC_RAW, &tspec);
 
@@ -241,14 +1236,30 @@ QSTimeCtr QS_onGetTime(void) {
 
 //............................................................................
 void QS_output(void) {
-    if (l_sock == INVALID_SOCKET) { // socket NOT initialized?
+    if ((l_sock == INVALID_SOCKET) && !QS_TRACE_ON_()) { // no QS output?
         FPRINTF_S(stderr, "<TARGET> ERROR   %s\n",
                   "invalid TCP socket");
         QF_stop(); // <== stop and exit the application
         return;
     }
 
+    QS_OVERFLOW_REPORT(); // report the QS overflow counters (if changed)
+
+#ifdef QS_TX_BATCH
+    // the TX thread sends the data, just wake it up for a full batch
+    if (QS_priv_.used >= (QSCtr)QS_TX_BATCH) {
+        l_txWake(false);
+    }
+#else
     QS_CRIT_STAT
+#ifdef QS_TRACE_FILE
+    if (QS_TRACE_ON_()) { // writing to the trace file?
+        QS_CRIT_ENTRY();
+        l_traceCopy();
+        QS_CRIT_EXIT();
+        return;
+    }
+#endif
     QS_CRIT_ENTRY();
     uint16_t nBytes = QS_TX_CHUNK;
     uint8_t const *data = QS_getBlock(&nBytes);
@@ -281,9 +1292,36 @@ void QS_output(void) {
             }
         }
     }
+#endif // def QS_TX_BATCH
 }
+
+#if (defined QS_OVERFLOW_POLICY) && (QS_OVERFLOW_POLICY == 2U)
+//............................................................................
+void QS_txWait_(void) {
+    if ((QS_priv_.used + QS_REC_MAX) <= QS_priv_.end) { // enough room?
+        return;
+    }
+#ifdef QS_TX_BATCH
+    if (l_txRun) { // the TX thread running?
+        static struct timespec const c_1ms = { 0, 1000000L };
+        l_txWake(true);
+        // wait at most QS_TIMEOUT_MS for the TX thread to make room
+        for (int i = 0; (i < (int)QS_TIMEOUT_MS)
+             && ((QS_priv_.used + QS_REC_MAX) > QS_priv_.end); ++i)
+        {
+            nanosleep(&c_1ms, NULL);
+        }
+        return;
+    }
+#endif
+    QS_onFlush(); // send the data in the calling thread
+}
+#endif
 //............................................................................
 void QS_rx_input(void) {
+    if (l_sock == INVALID_SOCKET) { // no QSPY (e.g., the trace file)?
+        return;
+    }
     int status = recv(l_sock,
                       (char *)QS_rxPriv_.buf, (int)QS_rxPriv_.end, 0);
     if (status > 0) { // any data received?
@@ -293,3 +1331,72 @@ void QS_rx_input(void) {
     }
 }
 
+//============================================================================
+// NOTE1:
+// With QS_THREAD_BUF defined (in qp_config.h), every thread that calls
+// QS_threadAttach() (the AO threads in this port) produces its trace
+// records into its own ring buffer of QS_THREAD_BUF bytes instead of
+// the shared QS buffer. The per-thread buffer has a single producer
+// (the owner thread) and a single consumer (the drain thread), so the
+// records are produced without any lock. Also, the QS critical section
+// (QS_CRIT_ENTRY()/QS_CRIT_EXIT()) locks the global QF mutex only in
+// the threads using the shared QS buffer.
+//
+// The drain thread merges the complete records from the per-thread buffers
+// into the shared QS buffer, from which they are output as before (e.g.,
+// QS_OUTPUT()). Every record in a per-thread buffer is preceded by its
+// time stamp (QS_onGetTime() at the beginning of the record, not output),
+// because not all records carry a time stamp and its position differs per
+// record type. The drain thread always merges the oldest of the head records
+// of all per-thread buffers (k-way merge), so the records complete at the
+// same time leave in the time order across the threads. The drain thread
+// re-numbers the records in the sequence of the shared QS buffer (and
+// corrects their checksums), so the output is unchanged for QSPY.
+//
+// The drain thread sleeps on a condition variable while there is nothing
+// to merge. QS_txEnd_() wakes it up after publishing a record, but signals
+// only the first record published since the drain thread started its last
+// merge cycle, so a burst of records costs a single wakeup.
+//
+// A record is lost (and counted, see QS_getThreadLost()) when the free
+// space in the per-thread buffer is below QS_THREAD_REC_MAX bytes, which
+// also must be enough for the longest record (e.g., QS_STR() strings).
+//
+// NOTE2:
+// With QS_TX_BATCH defined (in qp_config.h), the QS output is sent by
+// a dedicated TX thread, so that no application thread ever waits for
+// the socket. The TX thread sends when QS_TX_BATCH bytes are buffered
+// (checked in QS_OUTPUT() and after merging the per-thread buffers), or
+// QS_TX_LATENCY microseconds after the previous output, or when requested
+// by QS_onFlush() (e.g., QS_FLUSH() in QActive_start_()), which returns
+// immediately. The TX thread copies the data (also the data wrapped around
+// the end of the QS buffer) into its own buffer inside the critical section
+// and sends it from there, so that the producers can reuse the space in
+// the QS buffer right away, while a slow QSPY is waited for only in the TX
+// thread (poll() on the socket). QS_onCleanup() lets the TX thread send
+// the rest of the data. If the TX thread cannot do it (e.g., in Q_onError()
+// called inside a critical section), the rest is sent by QS_onFlush()
+// in the calling thread, as without QS_TX_BATCH.
+//
+// NOTE3:
+// With QS_TRACE_FILE defined (in qp_config.h), QS_onStartup("file:<path>")
+// writes the QS output into a circular memory-mapped file ("flight
+// recorder") instead of connecting to QSPY. The file consists of a header
+// with the write position (wrPos), a dictionary area with copies of the
+// dictionary and target-info records, and a ring of QS_TRACE_FILE bytes.
+// The header also keeps a few "sync points" (ring positions at which some
+// records begin), so that the oldest data in the wrapped ring can be
+// decoded from a record boundary. The kernel persists the mapped file even
+// if the process crashes, and the fatal signals (SIGSEGV, SIGBUS, SIGFPE,
+// SIGILL, SIGABRT) copy the QS data not yet written to the file. The tool
+// ports/posix/qs_trace2qspy.c extracts the file into a QSPY binary.
+//
+// NOTE4:
+// With QS_TSC_TIME defined (in qp_config.h), QS_onGetTime() on x86-64 reads
+// the time-stamp counter (rdtsc) instead of calling clock_gettime() for
+// every QS record. The invariant TSC is calibrated against
+// CLOCK_MONOTONIC_RAW in QS_onStartup() (~20ms), and the TSC ticks are
+// scaled to the same 100ns units, so the time stamps remain compatible
+// with QSPY. The QS_TIME_INFO record produced after QS_TARGET_INFO reports
+// the time source and the calibrated TSC frequency. Without the invariant
+// TSC (or on other CPUs) QS_onGetTime() uses clock_gettime() as before.
@@ -52,6 +52,12 @@
 #include <termios.h>
 #include <unistd.h>
 #include <signal.h>
+#include <errno.h>
+#include <fcntl.h>        // for open()
+#ifdef QF_EPOLL
+#include <sys/epoll.h>
+#include <sys/timerfd.h>
+#endif
 
 Q_DEFINE_THIS_MODULE("qf_port")
 
@@ -82,6 +88,21 @@ static void sigIntHandler(int dummy) {
 pthread_mutex_t QF_critSectMutex_ = PTHREAD_MUTEX_INITIALIZER;
 int_t QF_critSectNest_;
 
+#ifdef QF_TICK_BULK
+// # clock ticks missed by the ticker thread, see NOTE5 in qp_port.h
+static _Thread_local QTimeEvtCtr l_tickMissed;
+
+//............................................................................
+QTimeEvtCtr QF_tickMissed_(void) {
+    return l_tickMissed;
+}
+#endif // QF_TICK_BULK
+
+#ifdef QTIMEEVT_SHARDS
+// locks of the time event list shards, see NOTE8 in qp_port.h
+pthread_mutex_t QF_shardMutex_[QTIMEEVT_SHARDS];
+#endif // QTIMEEVT_SHARDS
+
 //............................................................................
 void QF_enterCriticalSection_(void) {
     pthread_mutex_lock(&QF_critSectMutex_);
@@ -96,6 +117,627 @@ void QF_leaveCriticalSection_(void) {
     }
 }
 
+//............................................................................
+// advance the timespec 'ts' by 'n' clock ticks
+static void l_tickAdd(struct timespec * const ts, QTimeEvtCtr const n) {
+    int64_t const nsec = (int64_t)n * (int64_t)l_tick.tv_nsec;
+    ts->tv_sec  += (time_t)(nsec / NSEC_PER_SEC);
+    ts->tv_nsec += (long)(nsec % NSEC_PER_SEC);
+    if (ts->tv_nsec >= NSEC_PER_SEC) {
+        ts->tv_nsec -= NSEC_PER_SEC;
+        ts->tv_sec  += 1;
+    }
+}
+
+#ifndef QF_TICKLESS
+//============================================================================
+// periodic clock tick with overrun policy and stats, see NOTE6 in qp_port.h
+
+static enum QF_TickOverrun l_tickOverrun; // policy for the late ticks
+static QF_TickStats l_tickStats;         // clock tick statistics
+
+//............................................................................
+// time elapsed since 'ts' [ns] (negative when 'ts' is in the future)
+static int64_t l_nsecSince(struct timespec const * const ts) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return ((int64_t)(now.tv_sec - ts->tv_sec) * NSEC_PER_SEC)
+           + (int64_t)(now.tv_nsec - ts->tv_nsec);
+}
+//............................................................................
+// log2 histogram bucket for the time 'nsec' (see NOTE6 in qp_port.h)
+static uint_fast8_t l_histBucket(int64_t const nsec) {
+    uint_fast8_t b = 0U;
+    for (int64_t us = nsec / 1000; (us > 0) && (b < (QF_TICK_HIST_LEN - 1U));
+         us >>= 1)
+    {
+        ++b;
+    }
+    return b;
+}
+//............................................................................
+// update the maximum 'max' [ns] (saturated at 32-bits)
+static void l_updateMax(uint32_t * const max, int64_t const nsec) {
+    uint32_t const n = (nsec > (int64_t)0xFFFFFFFF)
+                       ? 0xFFFFFFFFU
+                       : ((nsec > 0) ? (uint32_t)nsec : 0U);
+    if (*max < n) {
+        *max = n;
+    }
+}
+//............................................................................
+// process the clock tick after sleeping till 'next_tick' (absolute)
+static void l_clockTick(struct timespec * const next_tick) {
+    int64_t const late = l_nsecSince(next_tick);
+
+    // # whole tick periods missed (overrun)
+    QTimeEvtCtr missed = 0U;
+    if (late >= (int64_t)l_tick.tv_nsec) {
+        int64_t n = late / (int64_t)l_tick.tv_nsec;
+        QTimeEvtCtr const max = (QTimeEvtCtr)(~(QTimeEvtCtr)0) - 1U;
+        missed = (n > (int64_t)max) ? max : (QTimeEvtCtr)n;
+    }
+
+    QF_CRIT_STAT
+    QF_CRIT_ENTRY();
+    enum QF_TickOverrun const policy = l_tickOverrun;
+    QF_CRIT_EXIT();
+
+    if (missed > 0U) {
+        if (policy == QF_TICK_SKIP) {
+            l_tickAdd(next_tick, missed); // re-synchronize the tick phase
+        }
+#ifdef QF_TICK_BULK
+        else if (policy == QF_TICK_CATCH_UP) {
+            l_tickAdd(next_tick, missed); // re-synchronize the tick phase
+            l_tickMissed = missed; // catch up in bulk (NOTE5 in qp_port.h)
+        }
+#endif
+        else {
+            // keep the tick phase, so the missed ticks run back-to-back
+        }
+    }
+
+    struct timespec start;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+
+    QF_onClockTick(); // must call QTIMEEVT_TICK_X()
+
+    int64_t const dur = l_nsecSince(&start);
+#ifdef QF_TICK_BULK
+    l_tickMissed = 0U;
+#endif
+
+    QF_CRIT_ENTRY();
+    ++l_tickStats.nTicks;
+    ++l_tickStats.late[l_histBucket(late)];
+    ++l_tickStats.dur[l_histBucket(dur)];
+    l_updateMax(&l_tickStats.lateMax, late);
+    l_updateMax(&l_tickStats.durMax, dur);
+    if (missed > 0U) {
+        ++l_tickStats.nOverruns;
+        l_tickStats.nMissed += missed;
+    }
+    if (dur > (int64_t)l_tick.tv_nsec) { // callback longer than a period?
+        ++l_tickStats.nLong;
+    }
+    QF_CRIT_EXIT();
+}
+//............................................................................
+void QF_setTickOverrun(enum QF_TickOverrun const policy) {
+    QF_CRIT_STAT
+    QF_CRIT_ENTRY();
+    Q_REQUIRE_INCRIT(520, policy <= QF_TICK_BACK_TO_BACK);
+    l_tickOverrun = policy;
+    QF_CRIT_EXIT();
+}
+//............................................................................
+void QF_getTickStats(QF_TickStats * const stats, bool const reset) {
+    QF_CRIT_STAT
+    QF_CRIT_ENTRY();
+    *stats = l_tickStats;
+    if (reset) {
+        memset(&l_tickStats, 0, sizeof(l_tickStats));
+    }
+    QF_CRIT_EXIT();
+}
+//............................................................................
+#ifdef Q_SPY
+void QF_traceTickStats(enum_t const rec) {
+    QF_TickStats stats;
+    QF_getTickStats(&stats, false);
+
+    QS_BEGIN_ID(rec, 0U)
+        QS_U32(0, stats.nTicks);
+        QS_U32(0, stats.nOverruns);
+        QS_U32(0, stats.nMissed);
+        QS_U32(0, stats.nLong);
+        QS_U32(0, stats.lateMax);
+        QS_U32(0, stats.durMax);
+        for (uint_fast8_t i = 0U; i < QF_TICK_HIST_LEN; ++i) {
+            QS_U32(0, stats.late[i]);
+        }
+        for (uint_fast8_t i = 0U; i < QF_TICK_HIST_LEN; ++i) {
+            QS_U32(0, stats.dur[i]);
+        }
+    QS_END()
+}
+#endif // Q_SPY
+#endif // QF_TICKLESS
+
+#ifdef QF_EPOLL
+//============================================================================
+// clock tick and I/O readiness in a single epoll loop, see NOTE07
+
+#define EPOLL_MAX_EVENTS 16
+
+static int l_epfd = -1;   // the epoll instance
+static int l_tickfd = -1; // the timerfd of the clock tick
+
+//............................................................................
+static void l_epollLoop(void) {
+    // the absolute monotonic time of the next clock tick
+    struct timespec next_tick;
+    clock_gettime(CLOCK_MONOTONIC, &next_tick);
+
+    // round down nanoseconds to the nearest configured period
+    next_tick.tv_nsec
+        = (next_tick.tv_nsec / l_tick.tv_nsec) * l_tick.tv_nsec;
+    l_tickAdd(&next_tick, 1U);
+
+    // periodic timerfd aligned with the ticks (absolute time)
+    struct itimerspec its;
+    its.it_value    = next_tick;
+    its.it_interval = l_tick;
+    int err = timerfd_settime(l_tickfd, TFD_TIMER_ABSTIME, &its, NULL);
+
+    QF_CRIT_STAT
+    QF_CRIT_ENTRY();
+    Q_ASSERT_INCRIT(700, err == 0); // the tick timer must be set
+    QF_CRIT_EXIT();
+
+    while (l_isRunning) { // the clock tick and I/O loop...
+        struct epoll_event evts[EPOLL_MAX_EVENTS];
+        int const n = epoll_wait(l_epfd, evts, EPOLL_MAX_EVENTS, -1);
+
+        for (int i = 0; i < n; ++i) {
+            if (evts[i].data.ptr == (void *)&l_tickfd) { // the clock tick?
+                uint64_t nExp;
+                // clear the timerfd readiness (the expiration count is
+                // not needed, because the ticks are tracked in next_tick)
+                (void)read(l_tickfd, &nExp, sizeof(nExp));
+
+                // process all due ticks per the overrun policy
+                while (l_isRunning && (l_nsecSince(&next_tick) >= 0)) {
+                    // clock tick callback (must call QTIMEEVT_TICK_X())
+                    // with the overrun policy and statistics
+                    l_clockTick(&next_tick);
+                    l_tickAdd(&next_tick, 1U);
+                }
+            }
+            else { // I/O readiness of a watched file descriptor
+                QFdEvt * const fe = (QFdEvt *)evts[i].data.ptr;
+                fe->revents = evts[i].events;
+
+                // QACTIVE_POST() asserts if the queue overflows
+                // NOTE: the QFdEvt is watched with EPOLLONESHOT, so it is
+                // posted again only after QFdEvt_rearm()
+                QACTIVE_POST(fe->act, &fe->super, &l_epfd);
+            }
+        }
+    }
+}
+//............................................................................
+void QFdEvt_ctor(QFdEvt * const me,
+    QActive * const act,
+    enum_t const sig)
+{
+    QF_CRIT_STAT
+    QF_CRIT_ENTRY();
+    Q_REQUIRE_INCRIT(710, (act != (QActive *)0)
+        && (sig >= (enum_t)Q_USER_SIG));
+    QF_CRIT_EXIT();
+
+    // NOTE: QFdEvt is a static event (poolId_ == 0)
+    me->super.sig     = (QSignal)sig;
+    me->super.refCtr_ = 0U;
+    me->super.evtTag_ = QEVT_MARKER;
+
+    me->act     = act;
+    me->fd      = -1;
+    me->events  = 0U;
+    me->revents = 0U;
+}
+//............................................................................
+bool QFdEvt_watch(QFdEvt * const me,
+    int const fd,
+    uint32_t const events)
+{
+    me->fd      = fd;
+    me->events  = events;
+    me->revents = 0U;
+
+    struct epoll_event ev;
+    ev.events   = events | EPOLLONESHOT;
+    ev.data.ptr = me;
+    return epoll_ctl(l_epfd, EPOLL_CTL_ADD, fd, &ev) == 0;
+}
+//............................................................................
+bool QFdEvt_rearm(QFdEvt * const me) {
+    struct epoll_event ev;
+    ev.events   = me->events | EPOLLONESHOT;
+    ev.data.ptr = me;
+    return epoll_ctl(l_epfd, EPOLL_CTL_MOD, me->fd, &ev) == 0;
+}
+//............................................................................
+bool QFdEvt_unwatch(QFdEvt * const me) {
+    struct epoll_event ev; // ignored, but required before Linux 2.6.9
+    ev.events   = 0U;
+    ev.data.ptr = me;
+    bool const ok = (epoll_ctl(l_epfd, EPOLL_CTL_DEL, me->fd, &ev) == 0);
+    me->fd = -1;
+    return ok;
+}
+#endif // QF_EPOLL
+
+#ifdef QF_TICKLESS
+//============================================================================
+// tickless (dynamic-tick) mode, see NOTE05
+
+#ifndef QF_TICKLESS_POLL
+#define QF_TICKLESS_POLL 10U
+#endif
+
+static pthread_cond_t l_tickCond;  // cond.var. to wake up the ticker
+static struct timespec l_lastTick; // time of the last credited tick
+static bool l_isTicking;           // ticker inside QF_onClockTick()?
+static bool l_tickStarted;         // tickless clock loop started?
+
+//............................................................................
+// the next tick that needs QF_onClockTick() [ticks], 0 means none: the
+// earliest expiry across all tick rates, but at most QF_TICKLESS_POLL
+// NOTE: must be called inside the critical section
+static QTimeEvtCtr l_nextExpiry(void) {
+    QTimeEvtCtr min = (QTimeEvtCtr)QF_TICKLESS_POLL;
+    for (uint_fast8_t tickRate = 0U;
+         tickRate < Q_DIM(QTimeEvt_timeEvtHead_);
+         ++tickRate)
+    {
+        QTimeEvtCtr const n = QTimeEvt_nextExpiry_(tickRate);
+        if ((n != 0U) && ((min == 0U) || (n < min))) {
+            min = n;
+        }
+    }
+    return min;
+}
+//............................................................................
+// credit the elapsed ticks that don't expire any time event in bulk and
+// return the # remaining ticks that need to be processed by QF_onClockTick()
+// NOTE: must be called inside the critical section
+static QTimeEvtCtr l_creditTicks(void) {
+    QTimeEvtCtr due = 0U;
+    if (!l_isTicking) { // not inside QTimeEvt_tick_()?
+        QTimeEvtCtr n = QF_tickElapsed_();
+        if (n > 0U) {
+            QTimeEvtCtr const min = l_nextExpiry();
+            if ((min != 0U) && (n >= min)) { // some time events expire?
+                due = (QTimeEvtCtr)(n - (min - 1U));
+                n   = (QTimeEvtCtr)(min - 1U);
+            }
+            if (n > 0U) {
+                for (uint_fast8_t tickRate = 0U;
+                     tickRate < Q_DIM(QTimeEvt_timeEvtHead_);
+                     ++tickRate)
+                {
+                    QTimeEvt_credit_(tickRate, n);
+                }
+                l_tickAdd(&l_lastTick, n);
+            }
+        }
+    }
+    return due;
+}
+//............................................................................
+QTimeEvtCtr QF_tickElapsed_(void) {
+    QTimeEvtCtr n = 0U;
+    if (l_tickStarted) {
+        struct timespec now;
+        clock_gettime(CLOCK_MONOTONIC, &now);
+        int64_t const nsec =
+            ((int64_t)(now.tv_sec - l_lastTick.tv_sec) * NSEC_PER_SEC)
+            + (int64_t)(now.tv_nsec - l_lastTick.tv_nsec);
+        if (nsec > 0) {
+            int64_t const ticks = nsec / (int64_t)l_tick.tv_nsec;
+            QTimeEvtCtr const max = (QTimeEvtCtr)(~(QTimeEvtCtr)0);
+            n = (ticks < (int64_t)max) ? (QTimeEvtCtr)ticks : max;
+        }
+    }
+    return n;
+}
+//............................................................................
+void QF_tickSync_(void) {
+    (void)l_creditTicks(); // the due ticks are left to the ticker
+    pthread_cond_signal(&l_tickCond); // re-evaluate the next deadline
+}
+//............................................................................
+static void l_tickLoop(void) {
+    QF_CRIT_STAT
+    QF_CRIT_ENTRY();
+
+    // start counting ticks from now, rounded down to the configured period
+    clock_gettime(CLOCK_MONOTONIC, &l_lastTick);
+    l_lastTick.tv_nsec
+        = (l_lastTick.tv_nsec / l_tick.tv_nsec) * l_tick.tv_nsec;
+    l_tickStarted = true;
+
+    while (l_isRunning) { // the tickless clock loop...
+        if (l_creditTicks() == 0U) { // no ticks due yet?
+            QTimeEvtCtr const n = l_nextExpiry();
+
+            Q_ASSERT_INCRIT(500, QF_critSectNest_ == 1);
+            --QF_critSectNest_;
+            if (n != 0U) { // any time events armed or polling?
+                struct timespec deadline = l_lastTick;
+                l_tickAdd(&deadline, n);
+                // sleep until the deadline or until woken up
+                (void)pthread_cond_timedwait(&l_tickCond, &QF_critSectMutex_,
+                                             &deadline);
+            }
+            else { // nothing to wait for, sleep until woken up
+                (void)pthread_cond_wait(&l_tickCond, &QF_critSectMutex_);
+            }
+            Q_ASSERT_INCRIT(510, QF_critSectNest_ == 0);
+            ++QF_critSectNest_;
+        }
+        else { // at least one tick is due (time event expiry or polling)
+            l_tickAdd(&l_lastTick, 1U);
+            l_isTicking = true;
+            QF_CRIT_EXIT();
+
+            // clock tick callback (must call QTIMEEVT_TICK_X() once)
+            QF_onClockTick();
+
+            QF_CRIT_ENTRY();
+            l_isTicking = false;
+        }
+    }
+    l_tickStarted = false;
+    QF_CRIT_EXIT();
+}
+#endif // QF_TICKLESS
+
+#ifdef QF_MAX_HR_TIMER
+//============================================================================
+// high-resolution deadline timers, see NOTE06
+
+static QHrTimer *l_hrHeap[QF_MAX_HR_TIMER + 1U]; // min-heap (1-based)
+static uint_fast16_t l_hrLen;    // # armed timers in the heap
+static pthread_cond_t l_hrCond;  // cond.var. to wake up the timer thread
+
+//............................................................................
+// swap the heap entries 'i' and 'j' (called inside crit.sect.)
+static void l_hrSwap(uint_fast16_t const i, uint_fast16_t const j) {
+    QHrTimer * const t = l_hrHeap[i];
+    l_hrHeap[i] = l_hrHeap[j];
+    l_hrHeap[j] = t;
+    l_hrHeap[i]->idx = i;
+    l_hrHeap[j]->idx = j;
+}
+//............................................................................
+// restore the heap order at the entry 'i' (called inside crit.sect.)
+static void l_hrFix(uint_fast16_t i) {
+    // sift up...
+    while ((i > 1U)
+           && (l_hrHeap[i]->deadline < l_hrHeap[i >> 1U]->deadline))
+    {
+        l_hrSwap(i, i >> 1U);
+        i >>= 1U;
+    }
+    // sift down...
+    for (;;) {
+        uint_fast16_t const l = i << 1U;
+        uint_fast16_t m = i;
+        if ((l <= l_hrLen)
+            && (l_hrHeap[l]->deadline < l_hrHeap[m]->deadline))
+        {
+            m = l;
+        }
+        if (((l + 1U) <= l_hrLen)
+            && (l_hrHeap[l + 1U]->deadline < l_hrHeap[m]->deadline))
+        {
+            m = l + 1U;
+        }
+        if (m == i) {
+            break;
+        }
+        l_hrSwap(i, m);
+        i = m;
+    }
+}
+//............................................................................
+// remove the armed timer from the heap (called inside crit.sect.)
+static void l_hrRemove(QHrTimer * const t) {
+    uint_fast16_t const i = t->idx;
+    t->idx = 0U; // mark as disarmed
+    if (i != l_hrLen) { // not the last entry?
+        l_hrHeap[i] = l_hrHeap[l_hrLen];
+        l_hrHeap[i]->idx = i;
+        --l_hrLen;
+        l_hrFix(i);
+    }
+    else {
+        --l_hrLen;
+    }
+}
+//............................................................................
+static void *hrTimer_thread(void *arg); // prototype
+static void *hrTimer_thread(void *arg) { // for pthread_create()
+    Q_UNUSED_PAR(arg);
+
+    QF_CRIT_STAT
+    QF_CRIT_ENTRY();
+    while (l_isRunning) {
+        QHrTimer * const t = l_hrHeap[1];
+        int64_t const now = QF_monoNsec();
+        if ((l_hrLen == 0U) || (now < t->deadline)) { // nothing expired?
+            Q_ASSERT_INCRIT(610, QF_critSectNest_ == 1);
+            --QF_critSectNest_;
+            if (l_hrLen != 0U) { // sleep until the earliest deadline
+                struct timespec ts;
+                ts.tv_sec  = (time_t)(t->deadline / NSEC_PER_SEC);
+                ts.tv_nsec = (long)(t->deadline % NSEC_PER_SEC);
+                (void)pthread_cond_timedwait(&l_hrCond, &QF_critSectMutex_,
+                                             &ts);
+            }
+            else { // no timers armed, sleep until woken up
+                (void)pthread_cond_wait(&l_hrCond, &QF_critSectMutex_);
+            }
+            Q_ASSERT_INCRIT(620, QF_critSectNest_ == 0);
+            ++QF_critSectNest_;
+        }
+        else { // the earliest timer expired
+            QActive * const act = t->act;
+            if (t->interval != 0) { // periodic timer?
+                // advance to the next period in the future
+                // (the missed periods are skipped)
+                do {
+                    t->deadline += t->interval;
+                } while (t->deadline <= now);
+                l_hrFix(t->idx);
+            }
+            else { // one-shot timer
+                l_hrRemove(t);
+            }
+            QF_CRIT_EXIT(); // exit crit. section before posting
+
+            // QACTIVE_POST() asserts if the queue overflows
+            QACTIVE_POST(act, &t->super, (void *)0);
+
+            QF_CRIT_ENTRY();
+        }
+    }
+    QF_CRIT_EXIT();
+
+    return (void *)0; // return success
+}
+//............................................................................
+// start the timer thread at the highest p-thread priority, see NOTE04
+static void l_hrStart(void) {
+    pthread_attr_t attr;
+    pthread_attr_init(&attr);
+    pthread_attr_setschedpolicy (&attr, SCHED_FIFO);
+    pthread_attr_setinheritsched(&attr, PTHREAD_EXPLICIT_SCHED);
+    pthread_attr_setdetachstate (&attr, PTHREAD_CREATE_DETACHED);
+
+    struct sched_param param;
+    param.sched_priority = sched_get_priority_max(SCHED_FIFO);
+    pthread_attr_setschedparam(&attr, &param);
+
+    pthread_t thread;
+    int err = pthread_create(&thread, &attr, &hrTimer_thread, 0);
+    if (err != 0) {
+        // Creating the p-thread with the SCHED_FIFO policy failed.
+        // Most probably this application has no superuser privileges,
+        // so we just fall back to the default SCHED_OTHER policy
+        // and priority 0.
+        pthread_attr_setschedpolicy(&attr, SCHED_OTHER);
+        param.sched_priority = 0;
+        pthread_attr_setschedparam(&attr, &param);
+        err = pthread_create(&thread, &attr, &hrTimer_thread, 0);
+    }
+    QF_CRIT_STAT
+    QF_CRIT_ENTRY();
+    Q_ASSERT_INCRIT(630, err == 0); // timer thread must be created
+    QF_CRIT_EXIT();
+
+    pthread_attr_destroy(&attr);
+}
+//............................................................................
+int64_t QF_monoNsec(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return ((int64_t)now.tv_sec * NSEC_PER_SEC) + (int64_t)now.tv_nsec;
+}
+//............................................................................
+void QHrTimer_ctor(QHrTimer * const me,
+    QActive * const act,
+    enum_t const sig)
+{
+    QF_CRIT_STAT
+    QF_CRIT_ENTRY();
+    Q_REQUIRE_INCRIT(640, (act != (QActive *)0)
+        && (sig >= (enum_t)Q_USER_SIG));
+    QF_CRIT_EXIT();
+
+    // NOTE: QHrTimer is a static event (poolId_ == 0)
+    me->super.sig     = (QSignal)sig;
+    me->super.refCtr_ = 0U;
+    me->super.evtTag_ = QEVT_MARKER;
+
+    me->act      = act;
+    me->deadline = 0;
+    me->interval = 0;
+    me->idx      = 0U;
+}
+//............................................................................
+void QHrTimer_armAt(QHrTimer * const me,
+    int64_t const deadline,
+    int64_t const interval)
+{
+    QF_CRIT_STAT
+    QF_CRIT_ENTRY();
+
+    // the timer must be constructed, must NOT be armed, and the interval
+    // must not be negative
+    Q_REQUIRE_INCRIT(650, (me->act != (QActive *)0)
+        && (me->idx == 0U)
+        && (interval >= 0));
+
+    // the heap must not overflow
+    Q_REQUIRE_INCRIT(660, l_hrLen < QF_MAX_HR_TIMER);
+
+    me->deadline = deadline;
+    me->interval = interval;
+    ++l_hrLen;
+    l_hrHeap[l_hrLen] = me;
+    me->idx = l_hrLen;
+    l_hrFix(l_hrLen);
+
+    if (me->idx == 1U) { // the new earliest deadline?
+        pthread_cond_signal(&l_hrCond); // re-evaluate the deadline
+    }
+    QF_CRIT_EXIT();
+}
+//............................................................................
+void QHrTimer_armIn(QHrTimer * const me,
+    int64_t const nsec,
+    int64_t const interval)
+{
+    QHrTimer_armAt(me, QF_monoNsec() + nsec, interval);
+}
+//............................................................................
+bool QHrTimer_disarm(QHrTimer * const me) {
+    QF_CRIT_STAT
+    QF_CRIT_ENTRY();
+    bool const wasArmed = (me->idx != 0U);
+    if (wasArmed) {
+        l_hrRemove(me);
+        // NOTE: the timer thread does not need to be woken up, because
+        // waking up for the removed deadline is harmless
+    }
+    QF_CRIT_EXIT();
+    return wasArmed;
+}
+//............................................................................
+bool QHrTimer_isArmed(QHrTimer const * const me) {
+    QF_CRIT_STAT
+    QF_CRIT_ENTRY();
+    bool const isArmed = (me->idx != 0U);
+    QF_CRIT_EXIT();
+    return isArmed;
+}
+#endif // QF_MAX_HR_TIMER
+
 //............................................................................
 void QF_init(void) {
     // lock memory so we're never swapped out to disk
@@ -117,6 +759,44 @@ void QF_init(void) {
     l_tick.tv_nsec = NSEC_PER_SEC / DEFAULT_TICKS_PER_SEC; // default tick
     l_tickPrio = sched_get_priority_min(SCHED_FIFO); // default ticker prio
 
+#ifdef QTIMEEVT_SHARDS
+    for (uint_fast8_t shard = 0U; shard < QTIMEEVT_SHARDS; ++shard) {
+        pthread_mutex_init(&QF_shardMutex_[shard], NULL);
+    }
+#endif
+
+#ifdef QF_TICKLESS
+    // the ticker waits on the monotonic clock, see NOTE05
+    pthread_condattr_t cattr;
+    pthread_condattr_init(&cattr);
+    pthread_condattr_setclock(&cattr, CLOCK_MONOTONIC);
+    pthread_cond_init(&l_tickCond, &cattr);
+    pthread_condattr_destroy(&cattr);
+#endif
+
+#ifdef QF_EPOLL
+    // the epoll set with the clock tick timerfd, see NOTE07
+    l_epfd   = epoll_create1(EPOLL_CLOEXEC);
+    l_tickfd = timerfd_create(CLOCK_MONOTONIC, TFD_CLOEXEC);
+    struct epoll_event ev;
+    ev.events   = EPOLLIN;
+    ev.data.ptr = &l_tickfd;
+    int const err = epoll_ctl(l_epfd, EPOLL_CTL_ADD, l_tickfd, &ev);
+    QF_CRIT_STAT
+    QF_CRIT_ENTRY();
+    Q_ASSERT_INCRIT(720, (l_epfd >= 0) && (l_tickfd >= 0) && (err == 0));
+    QF_CRIT_EXIT();
+#endif
+
+#ifdef QF_MAX_HR_TIMER
+    // the timer thread waits on the monotonic clock, see NOTE06
+    pthread_condattr_t hattr;
+    pthread_condattr_init(&hattr);
+    pthread_condattr_setclock(&hattr, CLOCK_MONOTONIC);
+    pthread_cond_init(&l_hrCond, &hattr);
+    pthread_condattr_destroy(&hattr);
+#endif
+
     // install the SIGINT (Ctrl-C) signal handler
     struct sigaction sig_act;
     memset(&sig_act, 0, sizeof(sig_act));
@@ -148,9 +828,17 @@ int QF_run(void) {
     pthread_mutex_unlock(&l_startupMutex);
     l_isRunning = true;
 
+#ifdef QF_MAX_HR_TIMER
+    l_hrStart(); // start the high-resolution timer thread, see NOTE06
+#endif
+
     // The provided clock tick service configured?
     if ((l_tick.tv_sec != 0) || (l_tick.tv_nsec != 0)) {
-
+#ifdef QF_TICKLESS
+        l_tickLoop(); // tickless clock loop, see NOTE05
+#elif (defined QF_EPOLL)
+        l_epollLoop(); // clock tick and I/O readiness loop, see NOTE07
+#else
         // get the absolute monotonic time for no-drift sleeping
         static struct timespec next_tick;
         clock_gettime(CLOCK_MONOTONIC, &next_tick);
@@ -169,11 +857,18 @@ int QF_run(void) {
             }
 
             // sleep without drifting till next_time (absolute), see NOTE03
-            (void)clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME,
-                                  &next_tick, NULL);
+            while ((clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME,
+                                    &next_tick, NULL) == EINTR)
+                   && l_isRunning)
+            {
+                // interrupted by a signal, continue sleeping
+            }
+
             // clock tick callback (must call QTIMEEVT_TICK_X() once)
-            QF_onClockTick();
+            // with the overrun policy and statistics (NOTE6 in qp_port.h)
+            l_clockTick(&next_tick);
         }
+#endif // QF_TICKLESS
     }
     else { // The provided system clock tick NOT configured
 
@@ -192,12 +887,30 @@ int QF_run(void) {
 
     pthread_mutex_destroy(&l_startupMutex);
     pthread_mutex_destroy(&QF_critSectMutex_);
+#ifdef QTIMEEVT_SHARDS
+    for (uint_fast8_t shard = 0U; shard < QTIMEEVT_SHARDS; ++shard) {
+        pthread_mutex_destroy(&QF_shardMutex_[shard]);
+    }
+#endif
 
     return 0; // return success
 }
 //............................................................................
 void QF_stop(void) {
+#if (defined QF_TICKLESS) || (defined QF_MAX_HR_TIMER)
+    QF_CRIT_STAT
+    QF_CRIT_ENTRY();
     l_isRunning = false; // terminate the main (ticker) thread
+#ifdef QF_TICKLESS
+    pthread_cond_signal(&l_tickCond); // unblock the tickless ticker
+#endif
+#ifdef QF_MAX_HR_TIMER
+    pthread_cond_signal(&l_hrCond);   // unblock the timer thread
+#endif
+    QF_CRIT_EXIT();
+#else
+    l_isRunning = false; // terminate the main (ticker) thread
+#endif
 }
 //............................................................................
 void QF_setTickRate(uint32_t ticksPerSec, int tickPrio) {
@@ -247,6 +960,10 @@ static void *thread_routine(void *arg) { // the expected POSIX signature
     pthread_mutex_lock(&l_startupMutex);
     pthread_mutex_unlock(&l_startupMutex);
 
+#if (defined Q_SPY) && (defined QS_THREAD_BUF)
+    QS_threadAttach(); // own trace buffer (NOTE1 in qs_port.c)
+#endif
+
 #ifdef QACTIVE_CAN_STOP
     act->thread = true;
     while (act->thread)
@@ -256,6 +973,7 @@ static void *thread_routine(void *arg) { // the expected POSIX signature
     {
         QEvt const *e = QActive_get_(act); // wait for event
         QASM_DISPATCH(&act->super, e, act->prio); // dispatch to the HSM
+        QACTIVE_RTC_END_(act);
         QF_gc(e); // check if the event is garbage, and collect it if so
     }
 #ifdef QACTIVE_CAN_STOP
@@ -264,6 +982,77 @@ static void *thread_routine(void *arg) { // the expected POSIX signature
     return (void *)0; // return success
 }
 
+#if (defined QACTIVE_LAT_HIST) || (defined QACTIVE_HIST)
+//............................................................................
+uint32_t QF_latTime_(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint32_t)((uint64_t)now.tv_sec * 1000000000U
+                      + (uint64_t)now.tv_nsec);
+}
+#endif // QACTIVE_LAT_HIST || QACTIVE_HIST
+
+#ifdef QACTIVE_HIST
+
+static char const *l_histPath; // file for the dump in Q_onError()
+
+//............................................................................
+void QF_histDump(int const fd) {
+    // NOTE: this function does not lock the QF critical section (and uses
+    // only snprintf() and write()), so that it can be called from
+    // Q_onError(), possibly with the critical section already entered.
+    static char const * const kind[] = {
+        "post", "postLIFO", "dispatch", "tran"
+    };
+    static QHistEntry hist[QACTIVE_HIST];
+    char line[128];
+    for (uint_fast8_t p = 1U; p <= QF_MAX_ACTIVE; ++p) {
+        QActive const * const a = QActive_registry_[p];
+        if (a == (QActive *)0) {
+            continue;
+        }
+        uint_fast16_t const n = QActive_getHist(a, hist, Q_DIM(hist));
+        int len = snprintf(line, sizeof(line),
+            "AO prio=%u @%p history (time[ns] kind sig nFree addr):\n",
+            (unsigned)p, (void const *)a);
+        (void)write(fd, line, (size_t)len);
+        for (uint_fast16_t i = 0U; i < n; ++i) {
+            QHistEntry const * const h = &hist[i];
+            len = snprintf(line, sizeof(line),
+                "  %10u %-8s sig=%-5u nFree=%-3u %p\n",
+                (unsigned)h->stamp,
+                (h->kind < Q_DIM(kind)) ? kind[h->kind] : "?",
+                (unsigned)h->sig, (unsigned)h->nFree,
+                (void const *)h->addr);
+            (void)write(fd, line, (size_t)len);
+        }
+    }
+}
+//............................................................................
+void QF_histFile(char const * const path) {
+    l_histPath = path;
+}
+//............................................................................
+void QF_histOnError_(void) {
+    static bool dumped; // dump only once (e.g., nested assertions)
+    if (!dumped) {
+        dumped = true;
+        int fd = 2; // stderr by default
+        if (l_histPath != (char const *)0) {
+            fd = open(l_histPath, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+            if (fd < 0) {
+                fd = 2;
+            }
+        }
+        QF_histDump(fd);
+        if (fd != 2) {
+            (void)close(fd);
+        }
+    }
+}
+
+#endif // QACTIVE_HIST
+
 // QActive functions =======================================================
 void QActive_start_(QActive * const me, QPrioSpec const prioSpec,
                     QEvt const * * const qSto, uint_fast16_t const qLen,
@@ -352,7 +1141,8 @@ void QActive_setAttr(QActive *const me, uint32_t attr1, void const *attr2) {
 // Any blocking system call, such as clock_nanosleep() system call can
 // be interrupted by a signal, such as ^C from the keyboard. In this case this
 // QF port breaks out of the event-loop and returns to main() that exits and
-// terminates all spawned p-threads.
+// terminates all spawned p-threads. The ticker resumes the clock_nanosleep()
+// interrupted by any other signal, so it never ticks early.
 //
 // NOTE04:
 // According to the man pages (for pthread_attr_setschedpolicy) the only value
@@ -369,4 +1159,32 @@ void QActive_setAttr(QActive *const me, uint32_t attr1, void const *attr2) {
 // three highest p-thread priorities for the ISR-like threads (e.g., I/O),
 // and the rest highest-priorities for the active objects.
 //
-
+//
+// NOTE05:
+// In the tickless mode (QF_TICKLESS defined), the ticker sleeps on the
+// condition variable l_tickCond until the earliest time event expiry, but
+// at most QF_TICKLESS_POLL ticks (indefinitely when QF_TICKLESS_POLL is 0
+// and no time events are armed). The ticks elapsed in the meantime are
+// credited to all time events in bulk, so that only the tick that expires
+// a time event or ends the QF_TICKLESS_POLL period goes through
+// QF_onClockTick(). The latter keeps the applications working that poll
+// their inputs (e.g., keyboard, QS-RX) in QF_onClockTick().
+// Arming, re-arming, or disarming a time event calls QF_tickSync_(), which
+// credits the ticks elapsed so far and wakes up the ticker to re-evaluate
+// the deadline.
+//
+// NOTE06:
+// The high-resolution deadline timers (QF_MAX_HR_TIMER defined) are
+// serviced by a separate timer thread, which waits on the condition
+// variable l_hrCond (configured for CLOCK_MONOTONIC) until the earliest
+// deadline in the heap. The wait uses the same mutex as the QF critical
+// section, so arming a timer with a new earliest deadline only needs to
+// signal l_hrCond. The expired timers are posted outside the critical
+// section, the same way as QTimeEvt_tick_() posts the time events.
+//
+// NOTE07:
+// The epoll loop (QF_EPOLL defined) replaces clock_nanosleep() with the
+// periodic timerfd l_tickfd, whose first expiry is aligned with the tick
+// period the same way as in the clock_nanosleep() loop. The ticks are
+// still tracked in the absolute 'next_tick', so the overrun policy and the
+// tick statistics work the same way (see NOTE6 in qp_port.h).
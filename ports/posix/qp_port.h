@@ -67,6 +67,9 @@ void QF_leaveCriticalSection_(void);
 void QF_setTickRate(uint32_t ticksPerSec, int tickPrio);
 
 // clock tick callback
+// (NOTE: in the tickless mode (QF_TICKLESS defined) QF_onClockTick() is
+// called only when a time event expires or QF_TICKLESS_POLL ticks elapse,
+// and must call QTIMEEVT_TICK_X() once for every tick rate used, see NOTE3)
 void QF_onClockTick(void);
 
 // abstractions for console access...
@@ -80,6 +83,169 @@ int QF_consoleWaitForKey(void);
 #include "qmpool.h"    // POSIX port needs the native memory-pool
 #include "qp.h"        // QP platform-independent public interface
 
+#ifdef QF_TICK_BULK
+// catch up with the clock ticks missed by the ticker in bulk, see NOTE5
+QTimeEvtCtr QF_tickMissed_(void);
+
+#undef QTIMEEVT_TICK_X
+#ifdef Q_SPY
+    #define QTIMEEVT_TICK_X(tickRate_, sender_) \
+        (QTimeEvt_tickN_((tickRate_), \
+            (QTimeEvtCtr)(QF_tickMissed_() + 1U), (sender_)))
+#else
+    #define QTIMEEVT_TICK_X(tickRate_, dummy) \
+        (QTimeEvt_tickN_((tickRate_), \
+            (QTimeEvtCtr)(QF_tickMissed_() + 1U), (void *)0))
+#endif
+#endif // QF_TICK_BULK
+
+//============================================================================
+#ifdef QF_MAX_HR_TIMER
+
+#if (QF_MAX_HR_TIMER < 1) || (0xFFFF < QF_MAX_HR_TIMER)
+#error "QF_MAX_HR_TIMER out of range. Valid range is 1..0xFFFF"
+#endif
+
+//! High-resolution deadline timer (POSIX ports only), see NOTE4
+typedef struct {
+    QEvt super;            //!< inherited QEvt (posted to the AO)
+    QActive *act;          //!< the AO that receives the timer event
+    int64_t deadline;      //!< absolute CLOCK_MONOTONIC expiry [ns]
+    int64_t interval;      //!< period [ns] (0 for one-shot timer)
+    uint_fast16_t idx;     //!< index in the timer heap (0 when disarmed)
+} QHrTimer;
+
+// the current CLOCK_MONOTONIC time [ns]
+int64_t QF_monoNsec(void);
+
+void QHrTimer_ctor(QHrTimer * const me,
+    QActive * const act,
+    enum_t const sig);
+
+// arm to expire at the absolute CLOCK_MONOTONIC 'deadline' [ns]
+void QHrTimer_armAt(QHrTimer * const me,
+    int64_t const deadline,
+    int64_t const interval);
+
+// arm to expire 'nsec' nanoseconds from now
+void QHrTimer_armIn(QHrTimer * const me,
+    int64_t const nsec,
+    int64_t const interval);
+
+bool QHrTimer_disarm(QHrTimer * const me);
+
+bool QHrTimer_isArmed(QHrTimer const * const me);
+
+#endif // QF_MAX_HR_TIMER
+
+//============================================================================
+#ifndef QF_TICKLESS
+
+//! policies for the late (overrun) clock ticks, see NOTE6
+enum QF_TickOverrun {
+    QF_TICK_CATCH_UP,    //!< catch up with the missed ticks (default)
+    QF_TICK_SKIP,        //!< drop the missed ticks
+    QF_TICK_BACK_TO_BACK //!< run the missed ticks back-to-back
+};
+
+//! # buckets in the clock tick histograms, see NOTE6
+#define QF_TICK_HIST_LEN 16U
+
+//! clock tick statistics, see NOTE6
+typedef struct {
+    uint32_t nTicks;    //!< # clock ticks processed
+    uint32_t nOverruns; //!< # clock ticks late by one period or more
+    uint32_t nMissed;   //!< total # periods missed in the overruns
+    uint32_t nLong;     //!< # QF_onClockTick() calls longer than a period
+    uint32_t lateMax;   //!< maximum clock tick lateness [ns]
+    uint32_t durMax;    //!< maximum QF_onClockTick() duration [ns]
+    uint32_t late[QF_TICK_HIST_LEN]; //!< histogram of the tick lateness
+    uint32_t dur[QF_TICK_HIST_LEN];  //!< histogram of the tick duration
+} QF_TickStats;
+
+// set the policy for the late (overrun) clock ticks
+void QF_setTickOverrun(enum QF_TickOverrun const policy);
+
+// copy the clock tick statistics and optionally reset them
+void QF_getTickStats(QF_TickStats * const stats, bool const reset);
+
+#ifdef Q_SPY
+// produce the clock tick statistics as the QS user record 'rec'
+void QF_traceTickStats(enum_t const rec);
+#endif
+
+#endif // QF_TICKLESS
+
+//============================================================================
+#if (defined QTIMEEVT_SHARDS) && (defined QF_TICKLESS)
+#error "QTIMEEVT_SHARDS cannot be combined with QF_TICKLESS"
+#endif
+
+//============================================================================
+#ifdef QF_EPOLL
+
+#ifdef QF_TICKLESS
+#error "QF_EPOLL cannot be combined with QF_TICKLESS"
+#endif
+
+//! File-descriptor readiness event (Linux epoll only), see NOTE7
+typedef struct {
+    QEvt super;        //!< inherited QEvt (posted to the AO)
+    QActive *act;      //!< the AO that receives the readiness event
+    int fd;            //!< the watched file descriptor
+    uint32_t events;   //!< the watched epoll events (EPOLLIN, EPOLLOUT,...)
+    uint32_t revents;  //!< the ready epoll events (valid when received)
+} QFdEvt;
+
+void QFdEvt_ctor(QFdEvt * const me,
+    QActive * const act,
+    enum_t const sig);
+
+// start watching the file descriptor 'fd' for the epoll 'events'
+bool QFdEvt_watch(QFdEvt * const me,
+    int const fd,
+    uint32_t const events);
+
+// re-enable the readiness event after the AO has handled it
+bool QFdEvt_rearm(QFdEvt * const me);
+
+// stop watching the file descriptor
+bool QFdEvt_unwatch(QFdEvt * const me);
+
+#endif // QF_EPOLL
+
+//============================================================================
+#if (defined QACTIVE_LAT_HIST) || (defined QACTIVE_HIST)
+
+// time source of the latency histograms and AO histories [ns]
+// (wraps around every ~4.3 s)
+#define QF_LAT_TIME() (QF_latTime_())
+uint32_t QF_latTime_(void);
+
+#endif // QACTIVE_LAT_HIST || QACTIVE_HIST
+
+#ifdef QACTIVE_LAT_HIST
+
+// the signal histograms are shared by the AO threads
+#define QF_LAT_INC_(ctr_) \
+    ((void)__atomic_fetch_add(&(ctr_), 1U, __ATOMIC_RELAXED))
+
+#endif // QACTIVE_LAT_HIST
+
+#ifdef QACTIVE_HIST
+
+// dump the histories of all AOs as text to the file descriptor 'fd'
+void QF_histDump(int const fd);
+
+// set the file for the automatic dump in Q_onError() (stderr by default)
+void QF_histFile(char const * const path);
+
+// the AO histories are dumped automatically before calling Q_onError()
+#define Q_ON_ERROR_HOOK_() (QF_histOnError_())
+void QF_histOnError_(void);
+
+#endif // QACTIVE_HIST
+
 //============================================================================
 // interface used only inside QF implementation, but not in applications
 
@@ -118,6 +284,27 @@ int QF_consoleWaitForKey(void);
     extern pthread_mutex_t QF_critSectMutex_;
     extern int_t QF_critSectNest_;
 
+    #ifdef QF_TICKLESS
+    // tickless mode: credit the elapsed ticks and wake up the ticker
+    #define QTIMEEVT_TICKLESS_SYNC_()    (QF_tickSync_())
+
+    // tickless mode: # ticks elapsed, but not credited to time events yet
+    #define QTIMEEVT_TICKLESS_ELAPSED_() (QF_tickElapsed_())
+
+    void QF_tickSync_(void);
+    QTimeEvtCtr QF_tickElapsed_(void);
+    #endif // QF_TICKLESS
+
+    #ifdef QTIMEEVT_SHARDS
+    // locks of the time event list shards, see NOTE8
+    #define QTIMEEVT_SHARD_LOCK_(shard_) \
+        ((void)pthread_mutex_lock(&QF_shardMutex_[(shard_)]))
+    #define QTIMEEVT_SHARD_UNLOCK_(shard_) \
+        ((void)pthread_mutex_unlock(&QF_shardMutex_[(shard_)]))
+
+    extern pthread_mutex_t QF_shardMutex_[QTIMEEVT_SHARDS];
+    #endif // QTIMEEVT_SHARDS
+
 #endif // QP_IMPL
 
 //============================================================================
@@ -156,6 +343,86 @@ int QF_consoleWaitForKey(void);
 // thread publishes events to higher-priority threads. This can lead to
 // (occasionally) unexpected event sequences.
 //
+// NOTE3:
+// In the tickless (dynamic-tick) mode, enabled by defining QF_TICKLESS in
+// qp_config.h, the ticker does not wake up every clock tick. Instead, it
+// sleeps until the earliest expiry of all armed time events, but at most
+// QF_TICKLESS_POLL ticks, and credits the ticks elapsed in the meantime in
+// bulk. Arming, re-arming or disarming a time event wakes up the ticker to
+// re-evaluate the deadline.
+// QF_onClockTick() is thus still called at least every QF_TICKLESS_POLL
+// ticks (default 10), so the applications that poll their inputs there
+// (like the examples polling the keyboard and QS-RX) keep working, only at
+// the lower rate. With QF_TICKLESS_POLL defined as 0, QF_onClockTick() is
+// called only for the time event expiries, and the ticker sleeps
+// indefinitely when no time event is armed. Such applications must then
+// poll their inputs elsewhere (e.g., in an AO with a periodic time event).
+// The tickless mode assumes that all tick rates are ticked at the same
+// period from QF_onClockTick() and that no other context (such as QTicker)
+// calls QTIMEEVT_TICK_X().
+//
+// NOTE4:
+// The high-resolution deadline timers (QHrTimer), enabled by defining
+// QF_MAX_HR_TIMER in qp_config.h, complement the tick-based QTimeEvt for
+// the timeouts finer than the clock tick (e.g., protocol retransmissions).
+// The timers are kept in a binary min-heap ordered by the absolute
+// CLOCK_MONOTONIC deadline in nanoseconds and are serviced by a dedicated
+// timer thread, which sleeps until the earliest deadline. Upon expiry, the
+// QHrTimer is posted to the owning AO as a normal (static) event, exactly
+// like QTimeEvt. QF_MAX_HR_TIMER is the maximum number of timers armed at
+// the same time.
+//
+// NOTE5:
+// With QF_TICK_BULK defined in qp_config.h, the ticker thread that wakes
+// up late, for example due to a scheduling delay, does not call
+// QF_onClockTick() for every missed tick under the QF_TICK_CATCH_UP policy.
+// Instead, it calls QF_onClockTick() once and records the number of missed
+// ticks for its own thread, which QF_tickMissed_() returns. The
+// QTIMEEVT_TICK_X() macro, redefined in this port only with QF_TICK_BULK,
+// then advances all time events by (QF_tickMissed_() + 1) ticks in a
+// single pass with QTimeEvt_tickN_(). In all other threads QF_tickMissed_()
+// always returns 0, so QTIMEEVT_TICK_X() works as usual there.
+// Without QF_TICK_BULK, QTIMEEVT_TICK_X() is not redefined and the missed
+// ticks are processed back-to-back also under the QF_TICK_CATCH_UP policy.
+//
+// NOTE6:
+// The periodic ticker (QF_TICKLESS not defined) measures for every clock
+// tick its lateness (the time between the nominal tick and the actual
+// wakeup) and the duration of QF_onClockTick(). Both are collected in
+// the QF_TickStats histograms, where the bucket 0 counts times below 1us,
+// the bucket k counts times in the range [2^(k-1), 2^k) microseconds, and
+// the last bucket counts all longer times. A tick late by one period or
+// more is an overrun, which is handled according to the QF_TickOverrun
+// policy set by QF_setTickOverrun():
+// - QF_TICK_CATCH_UP (default) re-synchronizes the tick phase and credits
+//   the missed ticks in bulk with QF_TICK_BULK (see NOTE5), or processes
+//   them back-to-back without QF_TICK_BULK,
+// - QF_TICK_SKIP re-synchronizes the tick phase and drops the missed ticks,
+// - QF_TICK_BACK_TO_BACK keeps the tick phase, so the missed ticks are
+//   processed back-to-back without sleeping (one tick per call).
+// The statistics can be read by QF_getTickStats() and produced as a QS
+// user record (with the given record ID) by QF_traceTickStats().
+//
+// NOTE7:
+// With QF_EPOLL defined (Linux only), the clock tick is a timerfd in an
+// epoll set, which is serviced by the ticker thread. Applications can add
+// their own file descriptors to the same epoll set with QFdEvt_watch(), so
+// the I/O readiness is turned into the QFdEvt events posted directly to
+// the chosen AOs, without a separate I/O thread. A QFdEvt is a static
+// event, which is watched with EPOLLONESHOT. After the AO handles the
+// readiness (e.g., reads the socket), it must call QFdEvt_rearm() to
+// receive the next QFdEvt for the same file descriptor. The epoll events
+// (EPOLLIN, EPOLLOUT, etc.) are defined in <sys/epoll.h>.
+//
+// NOTE8:
+// With QTIMEEVT_SHARDS defined, the time events of every tick rate are
+// kept in QTIMEEVT_SHARDS separate lists by the priority of the owning AO.
+// Every list is protected by its own mutex QF_shardMutex_[], which the
+// time event operations (arming, disarming, etc.) lock instead of the global
+// critical section, and which the ticker thread locks while walking that
+// list. The critical section may be nested inside the shard mutex (for
+// tracing), but a shard mutex is never locked inside the critical section.
+//
 
 #endif // QP_PORT_H_
 
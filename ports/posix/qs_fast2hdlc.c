@@ -0,0 +1,197 @@
+//============================================================================
+// QP/C Real-Time Embedded Framework (RTEF)
+// Copyright (C) 2005 Quantum Leaps, LLC. All rights reserved.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later OR LicenseRef-QL-commercial
+//
+// This software is dual-licensed under the terms of the open source GNU
+// General Public License version 3 (or any later version), or alternatively,
+// under the terms of one of the closed source Quantum Leaps commercial
+// licenses.
+//
+// The terms of the open source GNU General Public License version 3
+// can be found at: <www.gnu.org/licenses/gpl-3.0>
+//
+// The terms of the closed source Quantum Leaps commercial licenses
+// can be found at: <www.state-machine.com/licensing>
+//
+// Redistributions in source code must retain this top-level comment block.
+// Plagiarizing this software to sidestep the license obligations is illegal.
+//
+// Contact information:
+// <www.state-machine.com>
+// <info@state-machine.com>
+//============================================================================
+//! @date Last updated on: 2023-12-13
+//! @version Last updated for: @ref qpc_7_3_0
+//!
+//! @file
+//! @brief Offline converter of the fast QS framing (QS_FAST_FRAMING)
+//! to the classic QS (HDLC) framing expected by QSPY
+//!
+//! @details
+//! This is a host utility, which is NOT linked with the application.
+//! Build it with any C99 compiler, for example:
+//!
+//! gcc -O2 -o qs_fast2hdlc qs_fast2hdlc.c
+//!
+//! Usage:
+//!
+//! qs_fast2hdlc [-c] [<fast-trace-file> [<qspy-trace-file>]]
+//!
+//! The option -c checks and removes the CRC of every record, which is
+//! needed when the target was built with QS_FAST_CRC. The standard input
+//! and output are used when the files are not specified.
+//!
+//! Every fast record begins with the sync byte QS_FAST_SYNC. A record is
+//! accepted only when it begins with the sync byte, has a plausible length
+//! and record ID, and is followed by the next sync byte (or the end of
+//! the input). With -c, the CRC must match as well. Otherwise, the input
+//! is scanned byte-by-byte for the next acceptable record, so that the
+//! conversion resynchronizes after a lost or corrupted part of the trace
+//! (e.g., the beginning of an overwritten trace file ring). The skipped
+//! bytes are counted and reported.
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define QS_FRAME     0x7EU
+#define QS_ESC       0x7DU
+#define QS_ESC_XOR   0x20U
+#define QS_FAST_SYNC 0xA5U // NOTE: must match QS_FAST_SYNC in qs_pkg.h
+#define QS_REC_ID_MAX 0x7CU // the largest QS record ID
+
+// CRC-16/CCITT-FALSE (polynomial 0x1021), the same as in QS_FAST_CRC
+static uint16_t crc16(uint16_t crc, uint8_t const *p, size_t n) {
+    for (; n != 0U; --n, ++p) {
+        crc ^= (uint16_t)((uint16_t)*p << 8U);
+        for (int i = 0; i < 8; ++i) {
+            crc = ((crc & 0x8000U) != 0U)
+                  ? (uint16_t)((uint16_t)(crc << 1U) ^ 0x1021U)
+                  : (uint16_t)(crc << 1U);
+        }
+    }
+    return crc;
+}
+
+// output the byte 'b' with the HDLC escaping
+static void putEsc(uint8_t const b, FILE *out) {
+    if ((b == QS_FRAME) || (b == QS_ESC)) {
+        fputc(QS_ESC, out);
+        fputc(b ^ QS_ESC_XOR, out);
+    }
+    else {
+        fputc(b, out);
+    }
+}
+
+//............................................................................
+int main(int argc, char *argv[]) {
+    bool hasCrc = false;
+    int arg = 1;
+    if ((arg < argc) && (strcmp(argv[arg], "-c") == 0)) {
+        hasCrc = true;
+        ++arg;
+    }
+
+    FILE *in  = stdin;
+    FILE *out = stdout;
+    if (arg < argc) {
+        in = fopen(argv[arg], "rb");
+        if (in == (FILE *)0) {
+            fprintf(stderr, "cannot open '%s' for reading\n", argv[arg]);
+            return 1;
+        }
+        ++arg;
+    }
+    if (arg < argc) {
+        out = fopen(argv[arg], "wb");
+        if (out == (FILE *)0) {
+            fprintf(stderr, "cannot open '%s' for writing\n", argv[arg]);
+            return 1;
+        }
+    }
+
+    // the whole input in memory (to slide over it when resynchronizing)
+    size_t size = 0U;
+    size_t cap  = 0x10000U;
+    uint8_t *buf = (uint8_t *)malloc(cap);
+    for (;;) {
+        if (buf == (uint8_t *)0) {
+            fprintf(stderr, "out of memory\n");
+            return 1;
+        }
+        size += fread(&buf[size], 1U, cap - size, in);
+        if (size < cap) {
+            break; // end of the input
+        }
+        cap *= 2U;
+        buf = (uint8_t *)realloc(buf, cap);
+    }
+
+    unsigned long nRec  = 0U;
+    unsigned long nSkip = 0U; // # bytes skipped to resynchronize
+    unsigned long nSync = 0U; // # times the stream was out of sync
+    bool inSync = true;
+    size_t pos = 0U;
+    while (pos < size) {
+        // the fast record: sync byte, 2-byte length (little-endian),
+        // the sequence number, record ID, data, and the optional CRC
+        uint8_t const * const rec = &buf[pos + 3U];
+        size_t len = 0U;
+        bool ok = ((size - pos) >= 5U) && (buf[pos] == QS_FAST_SYNC);
+        if (ok) {
+            len = (size_t)buf[pos + 1U] | ((size_t)buf[pos + 2U] << 8U);
+            ok = (len >= (hasCrc ? 4U : 2U))
+                 && (len <= (size - pos - 3U))
+                 && (rec[1] <= QS_REC_ID_MAX);
+        }
+        if (ok) { // the next record (if any) begins with the sync byte?
+            size_t const next = pos + 3U + len;
+            ok = (next == size) || (buf[next] == QS_FAST_SYNC);
+        }
+        if (ok && hasCrc) {
+            uint16_t const crc = (uint16_t)rec[len - 2U]
+                         | (uint16_t)((uint16_t)rec[len - 1U] << 8U);
+            // the CRC does not cover the sequence number
+            ok = (crc16(0xFFFFU, &rec[1], len - 3U) == crc);
+            len -= 2U;
+        }
+        if (!ok) { // out of sync?
+            if (inSync) {
+                inSync = false;
+                ++nSync;
+            }
+            ++nSkip;
+            ++pos; // slide by one byte
+            continue;
+        }
+        inSync = true;
+
+        // the classic QS frame: escaped sequence number, record ID, and
+        // data followed by the escaped checksum and the QS_FRAME byte
+        uint8_t chksum = 0U;
+        for (size_t i = 0U; i < len; ++i) {
+            chksum = (uint8_t)(chksum + rec[i]);
+            putEsc(rec[i], out);
+        }
+        putEsc((uint8_t)(chksum ^ 0xFFU), out);
+        fputc(QS_FRAME, out);
+        ++nRec;
+        pos += 3U + len + (hasCrc ? 2U : 0U);
+    }
+    free(buf);
+
+    fprintf(stderr, "%lu records converted, %lu bytes skipped "
+            "to resynchronize %lu times\n", nRec, nSkip, nSync);
+    if (out != stdout) {
+        fclose(out);
+    }
+    if (in != stdin) {
+        fclose(in);
+    }
+    return (nSync == 0U) ? 0 : 2;
+}
@@ -55,7 +55,54 @@ void QS_rx_input(void);  // handle the QS-RX input
 #include "qp_port.h" // use QS with QP
 #endif
 
+#ifdef QS_THREAD_BUF
+#if (QS_THREAD_BUF < 4096U) || (QS_THREAD_BUF > 65535U)
+#error QS_THREAD_BUF defined incorrectly, expected 4096U..65535U;
+#endif
+
+// per-thread trace buffers need the critical section only for
+// the shared QS buffer, see NOTE1 in qs_port.c
+#define QS_CRIT_STAT
+#define QS_CRIT_ENTRY()  QS_critEntry_()
+#define QS_CRIT_EXIT()   QS_critExit_()
+
+#ifdef QP_IMPL
+// the QS-TX state of the calling thread, see NOTE1 in qs_port.c
+#define QS_TX_           (*QS_tx_)
+#endif
+#define QS_TX_BEGIN_()   QS_txBegin_()
+#define QS_TX_END_()     QS_txEnd_()
+#endif // def QS_THREAD_BUF
+
+#if (defined QS_OVERFLOW_POLICY) && (QS_OVERFLOW_POLICY == 2U)
+// wait briefly for room in the QS buffer (see QS_OVERFLOW_POLICY)
+#define QS_TX_WAIT_()    QS_txWait_()
+void QS_txWait_(void);
+#endif
+
+#ifdef QS_TSC_TIME
+// report the QS time-stamp source after QS_TARGET_INFO (QS_TIME_INFO)
+#define QS_TARGET_INFO_EXT_() QS_timeInfo_()
+void QS_timeInfo_(void);
+#endif
+
 #include "qs.h"      // QS platform-independent public interface
 
+#ifdef QS_THREAD_BUF
+void QS_threadAttach(void);      // own trace buffer for the calling thread
+uint32_t QS_getThreadLost(void); // # records lost in full thread buffers
+
+void QS_critEntry_(void);
+void QS_critExit_(void);
+void QS_txBegin_(void);
+void QS_txEnd_(void);
+
+#ifdef QP_IMPL
+// QS-TX state of the calling thread (the shared QS_priv_ by default)
+// NOTE: used only in the QS implementation (C11), not in applications
+extern _Thread_local QS_Attr *QS_tx_;
+#endif
+#endif // def QS_THREAD_BUF
+
 #endif // QS_PORT_H_
 
@@ -0,0 +1,198 @@
+//============================================================================
+// QP/C Real-Time Embedded Framework (RTEF)
+// Copyright (C) 2005 Quantum Leaps, LLC. All rights reserved.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later OR LicenseRef-QL-commercial
+//
+// This software is dual-licensed under the terms of the open source GNU
+// General Public License version 3 (or any later version), or alternatively,
+// under the terms of one of the closed source Quantum Leaps commercial
+// licenses.
+//
+// The terms of the open source GNU General Public License version 3
+// can be found at: <www.gnu.org/licenses/gpl-3.0>
+//
+// The terms of the closed source Quantum Leaps commercial licenses
+// can be found at: <www.state-machine.com/licensing>
+//
+// Redistributions in source code must retain this top-level comment block.
+// Plagiarizing this software to sidestep the license obligations is illegal.
+//
+// Contact information:
+// <www.state-machine.com>
+// <info@state-machine.com>
+//============================================================================
+//! @date Last updated on: 2023-12-13
+//! @version Last updated for: @ref qpc_7_3_0
+//!
+//! @file
+//! @brief Offline extractor of the memory-mapped QS trace file (QS_TRACE_FILE)
+//! into a QS binary for QSPY
+//!
+//! @details
+//! This is a host utility, which is NOT linked with the application.
+//! Build it with any C99 compiler, for example:
+//!
+//! gcc -O2 -o qs_trace2qspy qs_trace2qspy.c
+//!
+//! Usage:
+//!
+//! qs_trace2qspy <trace-file> [<qspy-trace-file>]
+//!
+//! The output contains the saved dictionary records followed by the
+//! complete records still present in the ring of the trace file, starting
+//! with the oldest record boundary known from the sync points. The output
+//! can be decoded by QSPY (e.g., qspy -f <qspy-trace-file>). If the target
+//! used QS_FAST_FRAMING, the output must be converted with qs_fast2hdlc
+//! (with the -c option for QS_FAST_CRC). The standard output is used when
+//! the output file is not specified.
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define QS_FRAME    0x7EU
+#define QS_FAST_SYNC 0xA5U // NOTE: must match QS_FAST_SYNC in qs_pkg.h
+#define QS_TRACE_SYNC 16U
+
+// header of the trace file
+// NOTE: must match the header in ports/posix/qs_port.c
+typedef struct {
+    char magic[8];
+    uint32_t hdrSize;
+    uint32_t dictSize;
+    uint32_t ringSize;
+    uint32_t flags;
+    uint32_t dictLen;
+    uint32_t nSync;
+    uint64_t wrPos;
+    uint64_t sync[QS_TRACE_SYNC];
+} QSTraceHdr;
+
+//............................................................................
+int main(int argc, char *argv[]) {
+    if (argc < 2) {
+        fprintf(stderr, "usage: %s <trace-file> [<qspy-trace-file>]\n",
+                argv[0]);
+        return 1;
+    }
+    FILE *in = fopen(argv[1], "rb");
+    if (in == (FILE *)0) {
+        fprintf(stderr, "cannot open '%s' for reading\n", argv[1]);
+        return 1;
+    }
+    QSTraceHdr hdr;
+    if ((fread(&hdr, sizeof(hdr), 1U, in) != 1U)
+        || (memcmp(hdr.magic, "QSTRACE1", sizeof(hdr.magic)) != 0)
+        || (hdr.ringSize == 0U)
+        || (hdr.dictLen > hdr.dictSize))
+    {
+        fprintf(stderr, "'%s' is not a QS trace file\n", argv[1]);
+        return 1;
+    }
+
+    uint8_t * const dict = (uint8_t *)malloc(hdr.dictSize);
+    uint8_t * const ring = (uint8_t *)malloc(hdr.ringSize);
+    if ((dict == (uint8_t *)0) || (ring == (uint8_t *)0)
+        || (fseek(in, (long)hdr.hdrSize, SEEK_SET) != 0)
+        || (fread(dict, 1U, hdr.dictSize, in) != hdr.dictSize)
+        || (fread(ring, 1U, hdr.ringSize, in) != hdr.ringSize))
+    {
+        fprintf(stderr, "cannot read the trace file '%s'\n", argv[1]);
+        return 1;
+    }
+    fclose(in);
+
+    FILE *out = stdout;
+    if (argc > 2) {
+        out = fopen(argv[2], "wb");
+        if (out == (FILE *)0) {
+            fprintf(stderr, "cannot open '%s' for writing\n", argv[2]);
+            return 1;
+        }
+    }
+
+    // the oldest data still in the ring
+    uint64_t const end = hdr.wrPos;
+    uint64_t start = (end > hdr.ringSize) ? (end - hdr.ringSize) : 0U;
+    bool const isFast = ((hdr.flags & 1U) != 0U);
+
+    // start at the oldest known record boundary
+    if (start > 0U) {
+        uint64_t best = end;
+        uint32_t const nSync = (hdr.nSync < QS_TRACE_SYNC)
+                               ? hdr.nSync : QS_TRACE_SYNC;
+        for (uint32_t i = 0U; i < nSync; ++i) {
+            if ((hdr.sync[i] > start) && (hdr.sync[i] < best)) {
+                best = hdr.sync[i];
+            }
+        }
+        if ((best == end) && !isFast) { // no sync point in the ring?
+            // the classic records begin after the QS_FRAME byte
+            while ((start < end)
+                   && (ring[start % hdr.ringSize] != QS_FRAME))
+            {
+                ++start;
+            }
+            best = (start < end) ? (start + 1U) : end;
+        }
+        else if (best == end) { // no sync point in the fast ring?
+            best = start; // qs_fast2hdlc resynchronizes at a sync byte
+        }
+        else {
+            // start at the sync point
+        }
+        start = best;
+    }
+
+    // the end of the last complete record in the ring
+    uint64_t stop = start;
+    if (isFast) {
+        for (uint64_t pos = start; (end - pos) >= 3U; ) {
+            if (ring[pos % hdr.ringSize] != QS_FAST_SYNC) { // no sync?
+                ++pos; // skip the byte (qs_fast2hdlc resynchronizes)
+                continue;
+            }
+            uint64_t const len = 3U
+                + (uint64_t)ring[(pos + 1U) % hdr.ringSize]
+                + ((uint64_t)ring[(pos + 2U) % hdr.ringSize] << 8U);
+            if ((end - pos) < len) {
+                break; // incomplete record
+            }
+            pos += len;
+            stop = pos;
+        }
+    }
+    else {
+        for (uint64_t pos = start; pos < end; ++pos) {
+            if (ring[pos % hdr.ringSize] == QS_FRAME) {
+                stop = pos + 1U;
+            }
+        }
+    }
+
+    // the dictionaries first, followed by the records in the ring
+    fwrite(dict, 1U, hdr.dictLen, out);
+    for (uint64_t pos = start; pos < stop; ) {
+        size_t const i = (size_t)(pos % hdr.ringSize);
+        size_t n = (size_t)hdr.ringSize - i;
+        if (n > (stop - pos)) {
+            n = (size_t)(stop - pos);
+        }
+        fwrite(&ring[i], 1U, n, out);
+        pos += n;
+    }
+
+    fprintf(stderr, "%u dictionary bytes, %llu of %llu trace bytes "
+            "extracted%s\n", (unsigned)hdr.dictLen,
+            (unsigned long long)(stop - start), (unsigned long long)end,
+            isFast ? " (convert with qs_fast2hdlc)" : "");
+    if (out != stdout) {
+        fclose(out);
+    }
+    free(ring);
+    free(dict);
+    return 0;
+}
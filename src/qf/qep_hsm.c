@@ -111,6 +111,31 @@ enum {
     QS_MEM_APP();                               \
     QS_CRIT_EXIT()
 
+#ifdef QHSM_ANCESTOR_CACHE
+// helper function to rebuild the cached superstate chain of the current
+// state. The chain is collected bottom-up and always ends with QHsm_top.
+static void QHsm_cacheAnc_(QAsm * const me) {
+    QF_CRIT_STAT
+    QStateHandler s = me->state.fun;
+    uint_fast8_t n = 0U;
+
+    me->anc[0] = s;
+    while (s != Q_STATE_CAST(&QHsm_top)) {
+        (void)QHSM_RESERVED_EVT_(s, Q_EMPTY_SIG); // find superstate of s
+        s = me->temp.fun;
+        ++n;
+
+        // the cached chain must not overflow
+        QF_CRIT_ENTRY();
+        Q_ASSERT_INCRIT(710, n < QHSM_ANCESTOR_CACHE);
+        QF_CRIT_EXIT();
+
+        me->anc[n] = s;
+    }
+    me->ancLen = (uint8_t)(n + 1U);
+}
+#endif // def QHSM_ANCESTOR_CACHE
+
 //! @endcond
 
 //$define${QEP::QHsm} vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
@@ -134,6 +159,10 @@ void QHsm_ctor(QHsm * const me,
     me->super.vptr      = &vtable;
     me->super.state.fun = Q_STATE_CAST(&QHsm_top);
     me->super.temp.fun  = initial;
+    #ifdef QHSM_ANCESTOR_CACHE
+    me->super.anc[0]    = Q_STATE_CAST(&QHsm_top);
+    me->super.ancLen    = 1U;
+    #endif
 }
 
 //${QEP::QHsm::init_} ........................................................
@@ -246,6 +275,9 @@ void QHsm_init_(
     QS_CRIT_EXIT();
 
     me->state.fun = t;   // change the current active state
+    #ifdef QHSM_ANCESTOR_CACHE
+    QHsm_cacheAnc_(me);  // rebuild the cached superstate chain
+    #endif
     #ifndef Q_UNSAFE
     me->temp.uint = ~me->state.uint;
     #endif
@@ -436,6 +468,11 @@ void QHsm_dispatch_(
     #endif // Q_SPY
 
     me->state.fun = t; // change the current active state
+    #ifdef QHSM_ANCESTOR_CACHE
+    if (r >= Q_RET_TRAN) { // the state configuration changed?
+        QHsm_cacheAnc_(me); // rebuild the cached superstate chain
+    }
+    #endif
     #ifndef Q_UNSAFE
     me->temp.uint = ~me->state.uint;
     #endif
@@ -455,14 +492,23 @@ bool QHsm_isIn_(
     QAsm * const me,
     QStateHandler const state)
 {
+    bool inState = false; // assume that this HSM is not in 'state'
+
+    #ifdef QHSM_ANCESTOR_CACHE
+    // scan the cached state hierarchy bottom-up (no handler calls)
+    for (uint_fast8_t i = 0U; i < (uint_fast8_t)me->ancLen; ++i) {
+        if (me->anc[i] == state) { // do the states match?
+            inState = true;  // 'true' means that match found
+            break; // break out of the for-loop
+        }
+    }
+    #else
     QF_CRIT_STAT
     QF_CRIT_ENTRY();
     Q_REQUIRE_INCRIT(602, me->state.uint
                       == (uintptr_t)(~me->temp.uint));
     QF_CRIT_EXIT();
 
-    bool inState = false; // assume that this HSM is not in 'state'
-
     // scan the state hierarchy bottom-up
     QStateHandler s = me->state.fun;
     int_fast8_t limit = QHSM_MAX_NEST_DEPTH_ + 1; // loop hard limit
@@ -485,6 +531,7 @@ bool QHsm_isIn_(
     #ifndef Q_UNSAFE
     me->temp.uint = ~me->state.uint;
     #endif
+    #endif // def QHSM_ANCESTOR_CACHE
 
     return inState; // return the status
 }
@@ -497,6 +544,16 @@ QStateHandler QHsm_childState(QHsm * const me,
     QStateHandler child = me->super.state.fun; // start with current state
     bool isFound = false; // start with the child not found
 
+    #ifdef QHSM_ANCESTOR_CACHE
+    // scan the cached state hierarchy bottom-up (no handler calls)
+    for (uint_fast8_t i = 0U; i < (uint_fast8_t)me->super.ancLen; ++i) {
+        if (me->super.anc[i] == parent) { // is this the parent?
+            isFound = true; // child is found
+            break;
+        }
+        child = me->super.anc[i];
+    }
+    #else
     // establish stable state configuration
     me->super.temp.fun = child;
     QState r;
@@ -515,6 +572,7 @@ QStateHandler QHsm_childState(QHsm * const me,
     #ifndef Q_UNSAFE
     me->super.temp.uint = ~me->super.state.uint;
     #endif
+    #endif // def QHSM_ANCESTOR_CACHE
 
     QF_CRIT_STAT
     QF_CRIT_ENTRY();
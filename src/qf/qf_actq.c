@@ -54,6 +54,155 @@
 Q_DEFINE_THIS_MODULE("qf_actq")
 
 //============================================================================
+#ifdef QACTIVE_LAT_HIST
+
+#ifndef QF_LAT_TIME
+#error QACTIVE_LAT_HIST requires the time source QF_LAT_TIME() in the port
+#endif
+
+// increment a counter shared by several AOs, which a port can define
+// as an atomic operation
+#ifndef QF_LAT_INC_
+#define QF_LAT_INC_(ctr_) (++(ctr_))
+#endif
+
+//! @cond INTERNAL
+
+#if (QACTIVE_LAT_SIGS > 0U)
+// latency histograms of the signals (shared by all AOs)
+static QLatHist l_latSig[QACTIVE_LAT_SIGS][QF_LAT_MAX_KIND];
+#endif
+
+// the histogram bin of the latency 't'
+static uint_fast8_t QLatHist_bin_(uint32_t const t) {
+    if (t < 4U) {
+        return (uint_fast8_t)t;
+    }
+    // binary search for the most significant 1-bit
+    uint_fast8_t msb = 0U;
+    uint32_t x = t;
+    if (x >= 0x10000U) { x >>= 16U; msb += 16U; }
+    if (x >= 0x100U)   { x >>= 8U;  msb += 8U;  }
+    if (x >= 0x10U)    { x >>= 4U;  msb += 4U;  }
+    if (x >= 0x4U)     { x >>= 2U;  msb += 2U;  }
+    if (x >= 0x2U)     {            msb += 1U;  }
+
+    // 4 bins for each power of 2
+    return (uint_fast8_t)((4U * (msb - 1U))
+                          + ((t >> (msb - 2U)) & 3U));
+}
+
+// add the sample 't' to the histogram 'h' owned by one AO
+static void QLatHist_add_(QLatHist * const h, uint32_t const t) {
+    ++h->cnt[QLatHist_bin_(t)];
+    if (h->max < t) {
+        h->max = t;
+    }
+}
+
+// record the post time of the event just queued (in a critical section)
+void QActive_latPost_(QActive * const me, bool const lifo) {
+    uint_fast8_t const n = me->latN;
+    if (n == QACTIVE_LAT_OFF_) {
+        // time stamps don't match the queue until the queue empties
+    }
+    else if (n == QACTIVE_LAT_HIST) { // no room for another time stamp?
+        me->latN = QACTIVE_LAT_OFF_;
+    }
+    else {
+        uint_fast8_t i;
+        if (lifo) { // the new event goes in front of the others
+            i = (me->latFront == 0U)
+                ? (uint_fast8_t)(QACTIVE_LAT_HIST - 1U)
+                : (uint_fast8_t)(me->latFront - 1U);
+            me->latFront = (uint8_t)i;
+        }
+        else {
+            i = (uint_fast8_t)(me->latFront + n);
+            if (i >= QACTIVE_LAT_HIST) {
+                i -= QACTIVE_LAT_HIST;
+            }
+        }
+        me->latStamp[i] = QF_LAT_TIME();
+        me->latN = (uint8_t)(n + 1U);
+    }
+}
+
+// re-stamp the event at the position 'pos' in the queue (0 == front),
+// which replaced a pending event in place (in a critical section)
+static void QActive_latSet_(QActive * const me, uint_fast8_t const pos) {
+    uint_fast8_t const n = me->latN;
+    if ((n != QACTIVE_LAT_OFF_) && (pos < n)) { // time stamp available?
+        uint_fast8_t i = (uint_fast8_t)(me->latFront + pos);
+        if (i >= QACTIVE_LAT_HIST) {
+            i -= QACTIVE_LAT_HIST;
+        }
+        me->latStamp[i] = QF_LAT_TIME();
+    }
+}
+
+// the event 'e' just removed from the queue (in a critical section)
+static void QActive_latGet_(QActive * const me, QEvt const * const e,
+    bool const isLast)
+{
+    uint32_t const now = QF_LAT_TIME();
+    uint_fast8_t const n = me->latN;
+    if ((n != 0U) && (n != QACTIVE_LAT_OFF_)) { // time stamp available?
+        uint_fast8_t const i = me->latFront;
+        uint32_t const dt = now - me->latStamp[i];
+        me->latFront = (uint8_t)(((i + 1U) < QACTIVE_LAT_HIST)
+                                 ? (i + 1U) : 0U);
+        me->latN = (uint8_t)(n - 1U);
+
+        QLatHist_add_(&me->lat[QF_LAT_QUEUE], dt);
+    #if (QACTIVE_LAT_SIGS > 0U)
+        if (e->sig < (QSignal)QACTIVE_LAT_SIGS) {
+            QLatHist_add_(&l_latSig[e->sig][QF_LAT_QUEUE], dt);
+        }
+    #endif
+    }
+    if (isLast) { // the queue becomes empty?
+        me->latFront = 0U; // the time stamps match the queue again
+        me->latN = 0U;
+    }
+    me->latSig = e->sig;
+    me->latStart = now;
+}
+
+//! @endcond
+
+#endif // def QACTIVE_LAT_HIST
+
+#ifdef QACTIVE_HIST
+
+//! @cond INTERNAL
+
+// add an entry to the history of the AO (in a critical section)
+void QActive_histAdd_(QActive * const me,
+    enum QHistKind const kind,
+    QSignal const sig,
+    uintptr_t const addr)
+{
+    uint32_t const ctr = me->histCtr;
+    QHistEntry * const h = &me->hist[ctr & (QACTIVE_HIST - 1U)];
+    #ifdef QF_LAT_TIME
+    h->stamp = QF_LAT_TIME();
+    #else
+    h->stamp = ctr;
+    #endif
+    h->sig   = sig;
+    h->kind  = (uint8_t)kind;
+    h->nFree = (me->eQueue.nFree < 0xFFU)
+               ? (uint8_t)me->eQueue.nFree
+               : 0xFFU;
+    h->addr  = addr;
+    me->histCtr = ctr + 1U;
+}
+
+//! @endcond
+
+#endif // def QACTIVE_HIST
+
 //$skip${QP_VERSION} vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
 // Check for the minimum required QP version
 #if (QP_VERSION < 730U) || (QP_VERSION != ((QP_RELEASE^4294967295U) % 0x3E8U))
@@ -91,6 +240,33 @@ bool QActive_post_(QActive * const me,
     Q_REQUIRE_INCRIT(102, (QEvt_verify_(e)) && (me->prio == pcopy));
     #endif
 
+    #ifdef QACTIVE_SIG_FILTER
+    if (QActive_sigIgnored_(me, e->sig)) { // signal filtered out?
+        ++me->nFiltered; // one more event rejected by the filter
+
+        QS_BEGIN_PRE_(QS_QF_ACTIVE_POST_FILTERED, me->prio)
+            QS_TIME_PRE_();       // timestamp
+            QS_OBJ_PRE_(sender);  // the sender object
+            QS_SIG_PRE_(e->sig);  // the signal of the event
+            QS_OBJ_PRE_(me);      // this active object (recipient)
+            QS_2U8_PRE_(QEvt_getPoolId_(e), e->refCtr_); // poolId & refCtr
+        QS_END_PRE_()
+
+        // is it a mutable event?
+        if (QEvt_getPoolId_(e) != 0U) {
+            QEvt_refCtr_inc_(e); // balanced by QF_gc() below
+        }
+
+        QF_MEM_APP();
+        QF_CRIT_EXIT();
+
+    #if (QF_MAX_EPOOL > 0U)
+        QF_gc(e); // recycle the event to avoid a leak
+    #endif
+        return true; // the AO would have ignored the event anyway
+    }
+    #endif // def QACTIVE_SIG_FILTER
+
     QEQueueCtr nFree = me->eQueue.nFree; // get volatile into temporary
 
     // test-probe#1 for faking queue overflow
@@ -173,6 +349,13 @@ bool QActive_post_(QActive * const me,
             --me->eQueue.head; // advance the head (counter clockwise)
         }
 
+    #ifdef QACTIVE_LAT_HIST
+        QActive_latPost_(me, false); // time stamp at the back of the queue
+    #endif
+    #ifdef QACTIVE_HIST
+        QActive_histAdd_(me, QF_HIST_POST, e->sig, (uintptr_t)sender);
+    #endif
+
         QF_MEM_APP();
         QF_CRIT_EXIT();
     }
@@ -290,10 +473,120 @@ void QActive_postLIFO_(QActive * const me,
         me->eQueue.ring[me->eQueue.tail] = frontEvt;
     }
 
+    #ifdef QACTIVE_LAT_HIST
+    QActive_latPost_(me, true); // time stamp in front of the queue
+    #endif
+    #ifdef QACTIVE_HIST
+    QActive_histAdd_(me, QF_HIST_POST_LIFO, e->sig, (uintptr_t)0);
+    #endif
+
     QF_MEM_APP();
     QF_CRIT_EXIT();
 }
 //$enddef${QF::QActive::postLIFO_} ^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^
+//$define${QF::QActive::postCoalesce_} vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+
+//${QF::QActive::postCoalesce_} ..............................................
+//! @private @memberof QActive
+bool QActive_postCoalesce_(QActive * const me,
+    QEvt const * const e,
+    uint_fast16_t const margin,
+    void const * const sender)
+{
+    #ifndef Q_SPY
+    Q_UNUSED_PAR(sender);
+    #endif
+
+    #ifdef Q_UTEST // test?
+    #if Q_UTEST != 0 // testing QP-stub?
+    if (me->super.temp.fun == Q_STATE_CAST(0)) { // QActiveDummy?
+        return QActiveDummy_fakePost_(me, e, margin, sender);
+    }
+    #endif
+    #endif
+
+    QF_CRIT_STAT
+    QF_CRIT_ENTRY();
+    QF_MEM_SYS();
+
+    #ifndef Q_UNSAFE
+    uint8_t const pcopy = (uint8_t)(~me->prio_dis);
+    Q_REQUIRE_INCRIT(802, (QEvt_verify_(e)) && (me->prio == pcopy));
+    #endif
+
+    // find the oldest pending event with the same signal and replace
+    // it in place, so that it keeps its position in the queue
+    QEvt const *old = me->eQueue.frontEvt;
+    QEQueueCtr pos = 0U; // position of the replaced event (0 == front)
+    if (old == (QEvt *)0) { // empty queue?
+        // nothing to coalesce with (old is already NULL)
+    }
+    else if (old->sig == e->sig) { // front event matches?
+        me->eQueue.frontEvt = e; // replace the front event
+    }
+    else { // scan the ring buffer from the tail (oldest) to the head
+        old = (QEvt *)0;
+        QEQueueCtr n = me->eQueue.end - me->eQueue.nFree; // # in the ring
+        QEQueueCtr i = me->eQueue.tail;
+        for (; n > 0U; --n) {
+            ++pos;
+            if (me->eQueue.ring[i]->sig == e->sig) { // signal matches?
+                old = me->eQueue.ring[i];
+                me->eQueue.ring[i] = e; // replace the event in place
+                break;
+            }
+            if (i == 0U) { // need to wrap the index?
+                i = me->eQueue.end; // wrap around
+            }
+            --i; // advance the index (counter clockwise)
+        }
+    }
+
+    bool status;
+    if (old != (QEvt *)0) { // pending event replaced?
+
+        // is it a mutable event?
+        if (QEvt_getPoolId_(e) != 0U) {
+            QEvt_refCtr_inc_(e); // increment the reference counter
+        }
+
+        QS_BEGIN_PRE_(QS_QF_ACTIVE_POST_COALESCE, me->prio)
+            QS_TIME_PRE_();       // timestamp
+            QS_OBJ_PRE_(sender);  // the sender object
+            QS_SIG_PRE_(e->sig);  // the signal of the event
+            QS_OBJ_PRE_(me);      // this active object (recipient)
+            QS_2U8_PRE_(QEvt_getPoolId_(e), e->refCtr_); // poolId & refCtr
+            QS_EQC_PRE_(me->eQueue.nFree); // # free entries
+        QS_END_PRE_()
+
+    #ifdef QACTIVE_LAT_HIST
+        // the queueing delay counts from the coalesced post
+        QActive_latSet_(me, (uint_fast8_t)pos);
+    #else
+        Q_UNUSED_PAR(pos);
+    #endif
+    #ifdef QACTIVE_HIST
+        QActive_histAdd_(me, QF_HIST_POST, e->sig, (uintptr_t)sender);
+    #endif
+
+        QF_MEM_APP();
+        QF_CRIT_EXIT();
+
+    #if (QF_MAX_EPOOL > 0U)
+        QF_gc(old); // recycle the replaced event
+    #endif
+        status = true;
+    }
+    else { // no pending event with this signal, post it regularly
+        QF_MEM_APP();
+        QF_CRIT_EXIT();
+
+        status = QActive_post_(me, e, margin, sender);
+    }
+
+    return status;
+}
+//$enddef${QF::QActive::postCoalesce_} ^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^
 //$define${QF::QActive::get_} vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
 
 //${QF::QActive::get_} .......................................................
@@ -340,12 +633,160 @@ QEvt const * QActive_get_(QActive * const me) {
         QS_END_PRE_()
     }
 
+    #ifdef QACTIVE_LAT_HIST
+    QActive_latGet_(me, e, me->eQueue.frontEvt == (QEvt *)0);
+    #endif
+    #ifdef QACTIVE_HIST
+    me->histSig   = e->sig;
+    me->histState = (uintptr_t)me->super.state.obj;
+    QActive_histAdd_(me, QF_HIST_DISPATCH, e->sig, me->histState);
+    #endif
+
     QF_MEM_APP();
     QF_CRIT_EXIT();
 
     return e;
 }
 //$enddef${QF::QActive::get_} ^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^
+//$define${QF::QActive::rtcEnd_} vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+
+//${QF::QActive::rtcEnd_} ....................................................
+#if (defined QACTIVE_LAT_HIST) || (defined QACTIVE_HIST)
+//! @private @memberof QActive
+void QActive_rtcEnd_(QActive * const me) {
+    #ifdef QACTIVE_HIST
+    // the RTC step changed the state? (rare compared to the dispatches)
+    uintptr_t const state = (uintptr_t)me->super.state.obj;
+    if (state != me->histState) {
+        QF_CRIT_STAT
+        QF_CRIT_ENTRY();
+        QF_MEM_SYS();
+        QActive_histAdd_(me, QF_HIST_TRAN, me->histSig, state);
+        QF_MEM_APP();
+        QF_CRIT_EXIT();
+    }
+    #endif
+
+    #ifdef QACTIVE_LAT_HIST
+    // NOTE: called by the AO's own thread (after dispatching the event),
+    // so the AO's histograms have only one writer and need no locking.
+    uint32_t const dt = QF_LAT_TIME() - me->latStart;
+    QLatHist_add_(&me->lat[QF_LAT_RTC], dt);
+    #if (QACTIVE_LAT_SIGS > 0U)
+    if (me->latSig < (QSignal)QACTIVE_LAT_SIGS) { // shared histogram?
+        QLatHist * const hs = &l_latSig[me->latSig][QF_LAT_RTC];
+        QF_LAT_INC_(hs->cnt[QLatHist_bin_(dt)]);
+        if (hs->max < dt) {
+            hs->max = dt; // might lose a concurrent update (benign)
+        }
+    }
+    #endif
+    #endif // def QACTIVE_LAT_HIST
+}
+#endif //  (defined QACTIVE_LAT_HIST) || (defined QACTIVE_HIST)
+//$enddef${QF::QActive::rtcEnd_} ^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^
+//$define${QF::QActive::getHist} vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+
+//${QF::QActive::getHist} ....................................................
+#ifdef QACTIVE_HIST
+//! @public @memberof QActive
+uint_fast16_t QActive_getHist(QActive const * const me,
+    QHistEntry * const buf,
+    uint_fast16_t const n)
+{
+    // NOTE: no critical section, so that the history can be obtained
+    // also in Q_onError() (e.g., with the critical section already
+    // entered). The entries added concurrently might be inconsistent.
+
+    uint32_t const ctr = me->histCtr;
+    uint32_t num = (ctr < QACTIVE_HIST) ? ctr : QACTIVE_HIST;
+    if (num > n) {
+        num = (uint32_t)n; // only the most recent entries fit
+    }
+    for (uint32_t i = 0U; i < num; ++i) { // the oldest entry first
+        buf[i] = me->hist[(ctr - num + i) & (QACTIVE_HIST - 1U)];
+    }
+    return (uint_fast16_t)num;
+}
+#endif // def QACTIVE_HIST
+//$enddef${QF::QActive::getHist} ^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^
+//$define${QF::QActive::getLat} vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+
+//${QF::QActive::getLat} .....................................................
+#ifdef QACTIVE_LAT_HIST
+//! @public @memberof QActive
+QLatHist const * QActive_getLat(QActive const * const me,
+    enum QLatKind const kind)
+{
+    QF_CRIT_STAT
+    QF_CRIT_ENTRY();
+    Q_REQUIRE_INCRIT(900, kind < QF_LAT_MAX_KIND);
+    QF_CRIT_EXIT();
+
+    return &me->lat[kind];
+}
+#endif // def QACTIVE_LAT_HIST
+//$enddef${QF::QActive::getLat} ^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^
+//$define${QF::QActive::ignoreSig} vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+
+//${QF::QActive::ignoreSig} ..................................................
+#ifdef QACTIVE_SIG_FILTER
+//! @public @memberof QActive
+void QActive_ignoreSig(QActive * const me,
+    enum_t const sig)
+{
+    QF_CRIT_STAT
+    QF_CRIT_ENTRY();
+    // reserved signals must never be filtered out
+    Q_REQUIRE_INCRIT(600, ((enum_t)Q_USER_SIG <= sig)
+                      && (sig < (enum_t)QACTIVE_SIG_FILTER));
+    QF_MEM_SYS();
+
+    me->sigFilter[(uint_fast16_t)sig >> 3U]
+        |= (uint8_t)(1U << ((uint_fast16_t)sig & 7U));
+
+    QF_MEM_APP();
+    QF_CRIT_EXIT();
+}
+#endif // def QACTIVE_SIG_FILTER
+//$enddef${QF::QActive::ignoreSig} ^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^
+//$define${QF::QActive::acceptSig} vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+
+//${QF::QActive::acceptSig} ..................................................
+#ifdef QACTIVE_SIG_FILTER
+//! @public @memberof QActive
+void QActive_acceptSig(QActive * const me,
+    enum_t const sig)
+{
+    QF_CRIT_STAT
+    QF_CRIT_ENTRY();
+    Q_REQUIRE_INCRIT(700, ((enum_t)Q_USER_SIG <= sig)
+                      && (sig < (enum_t)QACTIVE_SIG_FILTER));
+    QF_MEM_SYS();
+
+    me->sigFilter[(uint_fast16_t)sig >> 3U]
+        &= (uint8_t)(~(1U << ((uint_fast16_t)sig & 7U)) & 0xFFU);
+
+    QF_MEM_APP();
+    QF_CRIT_EXIT();
+}
+#endif // def QACTIVE_SIG_FILTER
+//$enddef${QF::QActive::acceptSig} ^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^
+//$define${QF::QActive::getNFiltered} vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+
+//${QF::QActive::getNFiltered} ...............................................
+#ifdef QACTIVE_SIG_FILTER
+//! @public @memberof QActive
+uint32_t QActive_getNFiltered(QActive const * const me) {
+    QF_CRIT_STAT
+    QF_CRIT_ENTRY();
+    uint32_t const n = me->nFiltered;
+    QF_CRIT_EXIT();
+
+    return n;
+}
+#endif // def QACTIVE_SIG_FILTER
+//$enddef${QF::QActive::getNFiltered} ^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^
 
 //$define${QF::QF-base::getQueueMin} vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
 
@@ -363,6 +804,126 @@ uint_fast16_t QF_getQueueMin(uint_fast8_t const prio) {
     return min;
 }
 //$enddef${QF::QF-base::getQueueMin} ^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^
+//$define${QF::QF-base::getSigLat} vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+
+//${QF::QF-base::getSigLat} ..................................................
+#ifdef QACTIVE_LAT_HIST
+//! @static @public @memberof QF
+QLatHist const * QF_getSigLat(
+    enum_t const sig,
+    enum QLatKind const kind)
+{
+    QF_CRIT_STAT
+    QF_CRIT_ENTRY();
+    Q_REQUIRE_INCRIT(910, kind < QF_LAT_MAX_KIND);
+    QF_CRIT_EXIT();
+
+    #if (QACTIVE_LAT_SIGS > 0U)
+    return ((0 <= sig) && (sig < (enum_t)QACTIVE_LAT_SIGS))
+           ? &l_latSig[sig][kind]
+           : (QLatHist *)0;
+    #else
+    Q_UNUSED_PAR(sig);
+    return (QLatHist *)0;
+    #endif
+}
+#endif // def QACTIVE_LAT_HIST
+//$enddef${QF::QF-base::getSigLat} ^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^
+//$define${QF::QF-base::latDump} vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+
+//${QF::QF-base::latDump} ....................................................
+#if (defined QACTIVE_LAT_HIST) && (defined Q_SPY)
+//! @static @public @memberof QF
+void QF_latDump(enum_t const rec) {
+    // one application-specific record 'rec' per histogram:
+    // kind (0/1: AO queue/RTC, 2/3: signal queue/RTC), the AO or signal,
+    // # samples, the median, 90th, 99th percentile, and the maximum
+    for (uint_fast8_t kind = 0U; kind < (2U * QF_LAT_MAX_KIND); ++kind) {
+        uint_fast16_t const n = (kind < QF_LAT_MAX_KIND)
+                                ? (QF_MAX_ACTIVE + 1U)
+                                : QACTIVE_LAT_SIGS;
+        for (uint_fast16_t i = 0U; i < n; ++i) {
+            QActive const *a = (QActive *)0;
+            QLatHist const *h;
+            if (kind < QF_LAT_MAX_KIND) {
+                a = QActive_registry_[i];
+                h = (a != (QActive *)0)
+                    ? &a->lat[kind]
+                    : (QLatHist *)0;
+            }
+            else {
+                h = QF_getSigLat((enum_t)i,
+                                 (enum QLatKind)(kind - QF_LAT_MAX_KIND));
+            }
+            uint32_t total = 0U;
+            if (h != (QLatHist *)0) {
+                for (uint_fast8_t b = 0U; b < QF_LAT_BINS; ++b) {
+                    total += h->cnt[b];
+                }
+            }
+            if (total != 0U) {
+                QS_BEGIN_ID(rec, 0U)
+                    QS_U8(0, kind);
+                    if (a != (QActive *)0) {
+                        QS_OBJ(a);
+                    }
+                    else {
+                        QS_SIG((QSignal)i, (void *)0);
+                    }
+                    QS_U32(0, total);
+                    QS_U32(0, QLatHist_quantile(h, 500U));
+                    QS_U32(0, QLatHist_quantile(h, 900U));
+                    QS_U32(0, QLatHist_quantile(h, 990U));
+                    QS_U32(0, h->max);
+                QS_END()
+            }
+        }
+    }
+}
+#endif //  (defined QACTIVE_LAT_HIST) && (defined Q_SPY)
+//$enddef${QF::QF-base::latDump} ^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^
+//$define${QF::types::QLatHist::quantile} vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+
+//${QF::types::QLatHist::quantile} ...........................................
+#ifdef QACTIVE_LAT_HIST
+//! @public @memberof QLatHist
+uint32_t QLatHist_quantile(QLatHist const * const me,
+    uint_fast16_t const permille)
+{
+    uint32_t total = 0U;
+    uint_fast8_t b;
+    for (b = 0U; b < QF_LAT_BINS; ++b) {
+        total += me->cnt[b];
+    }
+    if (total == 0U) {
+        return 0U;
+    }
+
+    // rank of the sample at the requested quantile (rounded up)
+    uint32_t const rank = (uint32_t)((((uint64_t)total * permille) + 999U)
+                                     / 1000U);
+    uint32_t sum = 0U;
+    for (b = 0U; b < (QF_LAT_BINS - 1U); ++b) {
+        sum += me->cnt[b];
+        if (sum >= rank) {
+            break;
+        }
+    }
+
+    // the upper bound of the bin 'b'
+    uint32_t upper;
+    if (b < 4U) {
+        upper = (uint32_t)b;
+    }
+    else {
+        uint_fast8_t const shift = (uint_fast8_t)((b / 4U) - 1U);
+        upper = ((uint32_t)(4U + (b & 3U)) << shift)
+                + (((uint32_t)1U << shift) - 1U);
+    }
+    return (upper < me->max) ? upper : me->max;
+}
+#endif // def QACTIVE_LAT_HIST
+//$enddef${QF::types::QLatHist::quantile} ^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^
 //$define${QF::QTicker} vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
 
 //${QF::QTicker} .............................................................
@@ -429,8 +990,9 @@ void QTicker_dispatch_(
     QF_MEM_APP();
     QF_CRIT_EXIT();
 
-    for (; nTicks > 0U; --nTicks) {
-        QTimeEvt_tick_((uint_fast8_t)QACTIVE_CAST_(me)->eQueue.head, me);
+    if (nTicks > 0U) { // catch up with all the accumulated ticks at once
+        QTimeEvt_tickN_((uint_fast8_t)QACTIVE_CAST_(me)->eQueue.head,
+                        (QTimeEvtCtr)nTicks, me);
     }
 }
 
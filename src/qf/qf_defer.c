@@ -53,6 +53,39 @@
 
 Q_DEFINE_THIS_MODULE("qf_defer")
 
+//============================================================================
+//! @cond INTERNAL
+
+// helper function to step the ring index 'idx' back by 'n' entries, which
+// means towards the newer events (ring buffer runs counter clockwise)
+static inline QEQueueCtr QEQueue_back_(QEQueue const * const eq,
+    QEQueueCtr const idx, QEQueueCtr const n)
+{
+    return (idx >= n) ? (QEQueueCtr)(idx - n)
+                      : (QEQueueCtr)((eq->end + idx) - n);
+}
+
+// helper function to return the i-th event in the FIFO order of a
+// non-empty queue 'eq' (i == 0 is the front event)
+static inline QEvt const * QEQueue_at_(QEQueue const * const eq,
+    QEQueueCtr const i)
+{
+    return (i == 0U) ? eq->frontEvt
+                     : eq->ring[QEQueue_back_(eq, eq->tail, i - 1U)];
+}
+
+// helper function to return the priority of a deferred signal
+static inline uint_fast8_t QDeferQueue_prio_(QDeferQueue const * const dq,
+    QSignal const sig)
+{
+    return ((uint_fast16_t)sig < (uint_fast16_t)dq->nSig)
+           ? (uint_fast8_t)dq->sigPrio[sig]
+           : 0U;
+}
+
+//! @endcond
+//============================================================================
+
 //$skip${QP_VERSION} vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
 // Check for the minimum required QP version
 #if (QP_VERSION < 730U) || (QP_VERSION != ((QP_RELEASE^4294967295U) % 0x3E8U))
@@ -172,3 +205,200 @@ uint_fast16_t QActive_flushDeferred(QActive const * const me,
     return n;
 }
 //$enddef${QF::QActive::flushDeferred} ^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^
+//$define${QF::QActive::deferPrio} vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+
+//${QF::QActive::deferPrio} ..................................................
+//! @protected @memberof QActive
+bool QActive_deferPrio(QActive const * const me,
+    struct QDeferQueue * const dq,
+    QEvt const * const e)
+{
+    // append the event at the back of the deferred queue (FIFO)
+    bool const status = QActive_defer(me, &dq->super, e);
+
+    if (status && (dq->sigPrio != (uint8_t *)0)) {
+        QF_CRIT_STAT
+        QF_CRIT_ENTRY();
+        QF_MEM_SYS();
+
+        QEQueue * const eq = &dq->super;
+        uint_fast8_t const p = QDeferQueue_prio_(dq, e->sig);
+
+        // # events in the ring buffer (the front event not included)
+        QEQueueCtr n = (QEQueueCtr)(eq->end - eq->nFree);
+        if (n > 0U) { // the event did not land in the front?
+            // ring index of the just appended (newest) event
+            QEQueueCtr i = (QEQueueCtr)(eq->head + 1U);
+            if (i == eq->end) { // need to wrap the index?
+                i = 0U;
+            }
+
+            // move older events of lower priority one slot towards the
+            // head, so that events of equal priority stay in FIFO order
+            for (; n > 1U; --n) {
+                QEQueueCtr j = (QEQueueCtr)(i + 1U); // older neighbor
+                if (j == eq->end) { // need to wrap the index?
+                    j = 0U;
+                }
+                if (QDeferQueue_prio_(dq, eq->ring[j]->sig) >= p) {
+                    break; // insertion point found
+                }
+                eq->ring[i] = eq->ring[j];
+                i = j;
+            }
+
+            // all ring events passed? compare with the front event
+            if ((n == 1U)
+                && (QDeferQueue_prio_(dq, eq->frontEvt->sig) < p))
+            {
+                eq->ring[i] = eq->frontEvt;
+                eq->frontEvt = e; // the event becomes the front event
+            }
+            else {
+                eq->ring[i] = e;
+            }
+        }
+
+        QF_MEM_APP();
+        QF_CRIT_EXIT();
+    }
+
+    return status;
+}
+//$enddef${QF::QActive::deferPrio} ^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^
+//$define${QF::QActive::recallN} vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+
+//${QF::QActive::recallN} ....................................................
+//! @protected @memberof QActive
+uint_fast16_t QActive_recallN(QActive * const me,
+    struct QEQueue * const eq,
+    uint_fast16_t const num)
+{
+    uint_fast16_t n = 0U;
+
+    #ifdef Q_UTEST // test?
+    #if Q_UTEST != 0 // testing QP-stub?
+    if (me->super.temp.fun == Q_STATE_CAST(0)) { // QActiveDummy?
+        while ((n < num) && QActive_recall(me, eq)) {
+            ++n;
+        }
+        return n;
+    }
+    #endif
+    #endif
+
+    QF_CRIT_STAT
+    QF_CRIT_ENTRY();
+    QF_MEM_SYS();
+
+    #ifdef QXK_H_
+    Q_REQUIRE_INCRIT(300, me->super.state.act != Q_ACTION_CAST(0));
+    #endif
+
+    // # events to recall is limited by the events available in the
+    // deferred queue and by the free entries in the AO's queue
+    if (eq->frontEvt != (QEvt *)0) {
+        n = (uint_fast16_t)((eq->end + 1U) - eq->nFree);
+    }
+    if (n > num) {
+        n = num;
+    }
+    if (n > (uint_fast16_t)me->eQueue.nFree) {
+        n = (uint_fast16_t)me->eQueue.nFree;
+    }
+
+    if (n > 0U) {
+    #ifdef Q_SPY
+        for (QEQueueCtr i = 0U; i < (QEQueueCtr)n; ++i) {
+            QEvt const * const e = QEQueue_at_(eq, i);
+            QS_BEGIN_PRE_(QS_QF_ACTIVE_RECALL, me->prio)
+                QS_TIME_PRE_();      // time stamp
+                QS_OBJ_PRE_(me);     // this active object
+                QS_OBJ_PRE_(eq);     // the deferred queue
+                QS_SIG_PRE_(e->sig); // the signal of the event
+                QS_2U8_PRE_(QEvt_getPoolId_(e), e->refCtr_); // poolId & refCtr
+            QS_END_PRE_()
+        }
+    #endif // Q_SPY
+
+        // splice the events to the front of the AO's queue, starting with
+        // the newest one, so that the recalled events keep their FIFO order.
+        // NOTE: the reference counters of mutable events don't change,
+        // because each event is moved from one queue to the other.
+        for (QEQueueCtr i = (QEQueueCtr)n; i > 0U; --i) {
+            QEvt const * const e = QEQueue_at_(eq, i - 1U);
+            QEvt const * const frontEvt = me->eQueue.frontEvt;
+            me->eQueue.frontEvt = e; // deliver the event directly to front
+
+            if (frontEvt == (QEvt *)0) { // was the queue empty?
+                QACTIVE_EQUEUE_SIGNAL_(me); // signal the event queue
+            }
+            else { // queue was not empty, leave the event in the ring-buffer
+                ++me->eQueue.tail;
+                if (me->eQueue.tail == me->eQueue.end) { // need to wrap?
+                    me->eQueue.tail = 0U; // wrap around
+                }
+                me->eQueue.ring[me->eQueue.tail] = frontEvt;
+            }
+            --me->eQueue.nFree; // one free entry less
+
+        #ifdef QACTIVE_LAT_HIST
+            QActive_latPost_(me, true); // the event goes to the front
+        #endif
+        #ifdef QACTIVE_HIST
+            QActive_histAdd_(me, QF_HIST_POST_LIFO, e->sig, (uintptr_t)0);
+        #endif
+        }
+
+        QEQueueCtr nFree = me->eQueue.nFree;
+        if (me->eQueue.nMin > nFree) {
+            me->eQueue.nMin = nFree; // update minimum so far
+        }
+
+        // remove the recalled events from the deferred queue
+        nFree = (QEQueueCtr)(eq->nFree + n);
+        eq->nFree = nFree;
+        if (nFree <= eq->end) { // any events left in the ring buffer?
+            eq->frontEvt = QEQueue_at_(eq, (QEQueueCtr)n);
+            eq->tail = QEQueue_back_(eq, eq->tail, (QEQueueCtr)n);
+        }
+        else {
+            eq->frontEvt = (QEvt *)0; // deferred queue becomes empty
+            eq->tail = QEQueue_back_(eq, eq->tail, (QEQueueCtr)(n - 1U));
+
+            // all entries in the queue must be free (+1 for fronEvt)
+            Q_ASSERT_INCRIT(310, nFree == (eq->end + 1U));
+        }
+    }
+    else {
+        QS_BEGIN_PRE_(QS_QF_ACTIVE_RECALL_ATTEMPT, me->prio)
+            QS_TIME_PRE_();      // time stamp
+            QS_OBJ_PRE_(me);     // this active object
+            QS_OBJ_PRE_(eq);     // the deferred queue
+        QS_END_PRE_()
+    }
+
+    QF_MEM_APP();
+    QF_CRIT_EXIT();
+
+    return n;
+}
+//$enddef${QF::QActive::recallN} ^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^
+//$define${QF::QDeferQueue} vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+
+//${QF::QDeferQueue} .........................................................
+QDeferQueue const * QDeferQueue_dummy;
+
+//${QF::QDeferQueue::init} ...................................................
+//! @public @memberof QDeferQueue
+void QDeferQueue_init(QDeferQueue * const me,
+    struct QEvt const ** const qSto,
+    uint_fast16_t const qLen,
+    uint8_t const * const sigPrio,
+    uint_fast16_t const nSig)
+{
+    QEQueue_init(&me->super, qSto, qLen);
+    me->sigPrio = sigPrio;
+    me->nSig    = (uint16_t)nSig;
+}
+//$enddef${QF::QDeferQueue} ^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^
@@ -159,6 +159,9 @@ void QActive_unregister_(QActive * const me) {
                       && (QActive_registry_[p] == me));
     QActive_registry_[p] = (QActive *)0; // free-up the prio. level
     me->super.state.fun = Q_STATE_CAST(0); // invalidate the state
+    #ifdef QHSM_ANCESTOR_CACHE
+    me->super.ancLen = 0U; // invalidate the cached superstate chain
+    #endif
 
     QF_MEM_APP();
     QF_CRIT_EXIT();
@@ -53,6 +53,173 @@
 
 Q_DEFINE_THIS_MODULE("qf_time")
 
+#ifdef QTIMEEVT_SLACK
+// delay the expiry 'nTicks' after the tick count 'now' to the nearest
+// batch boundary given by the 'mask' (see NOTE3)
+static inline QTimeEvtCtr QTimeEvt_align_(
+    QTimeEvtCtr const now,
+    QTimeEvtCtr const nTicks,
+    QTimeEvtCtr const mask)
+{
+    QTimeEvtCtr n = nTicks;
+    QTimeEvtCtr const rem = (QTimeEvtCtr)((QTimeEvtCtr)(now + n) & mask);
+    if (rem != 0U) { // not aligned yet?
+        QTimeEvtCtr const aligned = (QTimeEvtCtr)(n + ((mask - rem) + 1U));
+        if (aligned > n) { // no overflow?
+            n = aligned;
+        }
+    }
+    return n;
+}
+#endif // def QTIMEEVT_SLACK
+
+#ifdef QTIMEEVT_SHARDS
+
+#ifndef QTIMEEVT_SHARD_LOCK_
+    #error "QTIMEEVT_SHARDS requires QTIMEEVT_SHARD_LOCK_() in the QF port"
+#endif
+#ifdef QTIMEEVT_TICKLESS_SYNC_
+    #error "QTIMEEVT_SHARDS cannot be combined with the tickless mode"
+#endif
+#ifdef QXK_H_
+    #error "QTIMEEVT_SHARDS is not supported in the QXK kernel"
+#endif
+
+// the time event lists of the shards (per tick rate), see NOTE4
+static QTimeEvt l_shardHead[QTIMEEVT_SHARDS][QF_MAX_TICK_RATE];
+
+// the shard of the time event 'me' given by its owning AO, see NOTE4
+static inline uint_fast8_t QTimeEvt_shard_(QTimeEvt const * const me) {
+    // NOTE: the AO is checked in the preconditions (under the shard lock)
+    return (me->act != (void *)0)
+        ? (uint_fast8_t)(QACTIVE_CAST_(me->act)->prio % QTIMEEVT_SHARDS)
+        : 0U;
+}
+
+#define QTE_SHARDS_                 ((uint_fast8_t)QTIMEEVT_SHARDS)
+#define QTE_SHARD_(me_)             QTimeEvt_shard_(me_)
+#define QTE_HEAD_(shard_, rate_)    (&l_shardHead[(shard_)][(rate_)])
+#define QTE_LOCK_(shard_)           QTIMEEVT_SHARD_LOCK_(shard_)
+#define QTE_UNLOCK_(shard_)         QTIMEEVT_SHARD_UNLOCK_(shard_)
+
+// the data shared by all shards need the critical section nested
+// inside the shard lock (never the other way around)
+#define QTE_CRIT_ENTRY_()           QF_CRIT_ENTRY()
+#define QTE_CRIT_EXIT_()            QF_CRIT_EXIT()
+#ifdef Q_SPY
+    #define QTE_QS_CRIT_ENTRY_()    QF_CRIT_ENTRY()
+    #define QTE_QS_CRIT_EXIT_()     QF_CRIT_EXIT()
+#else
+    #define QTE_QS_CRIT_ENTRY_()    ((void)0)
+    #define QTE_QS_CRIT_EXIT_()     ((void)0)
+#endif
+
+#else // one time event list per tick rate (in the critical section)
+
+#define QTE_SHARDS_                 1U
+#define QTE_SHARD_(me_)             0U
+#define QTE_HEAD_(shard_, rate_)    (&QTimeEvt_timeEvtHead_[(rate_)])
+#define QTE_LOCK_(shard_)           QF_CRIT_ENTRY()
+#define QTE_UNLOCK_(shard_)         QF_CRIT_EXIT()
+#define QTE_CRIT_ENTRY_()           ((void)0)
+#define QTE_CRIT_EXIT_()            ((void)0)
+#define QTE_QS_CRIT_ENTRY_()        ((void)0)
+#define QTE_QS_CRIT_EXIT_()         ((void)0)
+
+#endif // def QTIMEEVT_SHARDS
+
+#ifdef QTIMEEVT_POST_POLICY
+// # expiries dropped/retried because of a full AO queue (per tick rate)
+static uint32_t l_nDropped[QF_MAX_TICK_RATE];
+static uint32_t l_nRetried[QF_MAX_TICK_RATE];
+
+// post the expired time event 'e' to the AO 'act' according to
+// the delivery policy of the time event (see NOTE5)
+static void QTimeEvt_post_(
+    QTimeEvt * const e,
+    QActive * const act,
+    uint_fast8_t const tickRate,
+    QTimeEvtCtr const nTicks,
+    void const * const sender)
+{
+    #ifndef Q_SPY
+    Q_UNUSED_PAR(sender);
+    #endif
+
+    uint_fast8_t const policy = ((uint_fast8_t)e->super.refCtr_ & QTE_POLICY)
+                                >> QTE_POLICY_SHIFT;
+
+    if (policy == (uint_fast8_t)QTIMEEVT_POLICY_ASSERT) {
+        // QACTIVE_POST() asserts if the queue overflows
+        QACTIVE_POST(act, &e->super, sender);
+    }
+    else if (!QACTIVE_POST_X(act, &e->super, 0U, sender)) { // queue full?
+        QF_CRIT_STAT
+        QTE_LOCK_(QTE_SHARD_(e));
+        QF_MEM_SYS();
+
+        bool retry = false;
+        if (policy == (uint_fast8_t)QTIMEEVT_POLICY_RETRY) {
+            if (e->interval != 0U) { // periodic time event?
+                if (e->ctr != 0U) { // not disarmed in the meantime?
+                    e->ctr = 1U; // expire again on the next tick
+                    retry = true;
+                }
+            }
+            // one-shot time event not re-armed in the meantime?
+            else if ((e->ctr == 0U)
+                     && ((e->super.refCtr_ & QTE_IS_LINKED) == 0U)
+                     && ((QTimeEvtCtr)(nTicks + 1U) != 0U))
+            {
+                // link 'e' to the list of the newly armed time events,
+                // which the current tick still processes (and decrements
+                // by nTicks), so that 'e' expires again on the next tick
+                e->ctr = (QTimeEvtCtr)(nTicks + 1U);
+                QTimeEvt * const head = QTE_HEAD_(QTE_SHARD_(e), tickRate);
+                e->next = (QTimeEvt *)head->act;
+                head->act = e;
+                e->super.refCtr_ |= QTE_IS_LINKED;
+                retry = true;
+            }
+            else {
+                // the time event was re-armed: drop this expiry
+            }
+        }
+
+        QTE_CRIT_ENTRY_(); // the counters are shared by all shards
+        if (retry) {
+            ++l_nRetried[tickRate];
+
+            QS_BEGIN_PRE_(QS_QF_TIMEEVT_POST_RETRY, act->prio)
+                QS_TIME_PRE_();            // timestamp
+                QS_OBJ_PRE_(e);            // the time event object
+                QS_SIG_PRE_(e->super.sig); // signal of this time event
+                QS_OBJ_PRE_(act);          // the target AO
+                QS_U8_PRE_(tickRate);      // tick rate
+            QS_END_PRE_()
+        }
+        else {
+            ++l_nDropped[tickRate];
+
+            QS_BEGIN_PRE_(QS_QF_TIMEEVT_POST_DROP, act->prio)
+                QS_TIME_PRE_();            // timestamp
+                QS_OBJ_PRE_(e);            // the time event object
+                QS_SIG_PRE_(e->super.sig); // signal of this time event
+                QS_OBJ_PRE_(act);          // the target AO
+                QS_U8_PRE_(tickRate);      // tick rate
+            QS_END_PRE_()
+        }
+        QTE_CRIT_EXIT_();
+
+        QF_MEM_APP();
+        QTE_UNLOCK_(QTE_SHARD_(e));
+    }
+    else {
+        // posted successfully
+    }
+}
+#endif // def QTIMEEVT_POST_POLICY
+
 //$skip${QP_VERSION} vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
 // Check for the minimum required QP version
 #if (QP_VERSION < 730U) || (QP_VERSION != ((QP_RELEASE^4294967295U) % 0x3E8U))
@@ -90,6 +257,9 @@ void QTimeEvt_ctorX(QTimeEvt * const me,
     me->act      = act;
     me->ctr      = 0U;
     me->interval = 0U;
+    #ifdef QTIMEEVT_SLACK
+    me->slackMask = 0U; // no slack
+    #endif
 }
 
 //${QF::QTimeEvt::armX} ......................................................
@@ -106,7 +276,7 @@ void QTimeEvt_armX(QTimeEvt * const me,
     #endif
 
     QF_CRIT_STAT
-    QF_CRIT_ENTRY();
+    QTE_LOCK_(QTE_SHARD_(me));
     QF_MEM_SYS();
 
     Q_REQUIRE_INCRIT(400, (me->act != (void *)0)
@@ -118,9 +288,19 @@ void QTimeEvt_armX(QTimeEvt * const me,
     Q_UNUSED_PAR(ctr);
     #endif
 
+    #ifdef QTIMEEVT_TICKLESS_SYNC_
+    QTIMEEVT_TICKLESS_SYNC_(); // credit the elapsed ticks, see NOTE1
+    #endif
+
     me->ctr = nTicks;
     me->interval = interval;
 
+    #ifdef QTIMEEVT_SLACK
+    // delay the expiry to the nearest batch boundary, see NOTE3
+    me->ctr = QTimeEvt_align_(QTE_HEAD_(QTE_SHARD_(me), tickRate)->interval,
+                              nTicks, me->slackMask);
+    #endif
+
     // is the time event unlinked?
     // NOTE: For the duration of a single clock tick of the specified tick
     // rate a time event can be disarmed and yet still linked into the list
@@ -135,10 +315,13 @@ void QTimeEvt_armX(QTimeEvt * const me,
         // list is appended to the main list of armed time events based on
         // QTimeEvt_timeEvtHead_[tickRate].next. Again, this is to keep any
         // changes to the main list exclusively inside the QTimeEvt_tick_().
-        me->next = (QTimeEvt *)QTimeEvt_timeEvtHead_[tickRate].act;
-        QTimeEvt_timeEvtHead_[tickRate].act = me;
+        // (With QTIMEEVT_SHARDS, the lists of the shard are used, see NOTE4.)
+        QTimeEvt * const head = QTE_HEAD_(QTE_SHARD_(me), tickRate);
+        me->next = (QTimeEvt *)head->act;
+        head->act = me;
     }
 
+    QTE_QS_CRIT_ENTRY_();
     QS_BEGIN_PRE_(QS_QF_TIMEEVT_ARM, qs_id)
         QS_TIME_PRE_();        // timestamp
         QS_OBJ_PRE_(me);       // this time event object
@@ -147,10 +330,37 @@ void QTimeEvt_armX(QTimeEvt * const me,
         QS_TEC_PRE_(interval); // the interval
         QS_U8_PRE_(tickRate);  // tick rate
     QS_END_PRE_()
+    QTE_QS_CRIT_EXIT_();
 
     QF_MEM_APP();
-    QF_CRIT_EXIT();
+    QTE_UNLOCK_(QTE_SHARD_(me));
+}
+
+//${QF::QTimeEvt::armSlack} ..................................................
+#ifdef QTIMEEVT_SLACK
+//! @public @memberof QTimeEvt
+void QTimeEvt_armSlack(QTimeEvt * const me,
+    QTimeEvtCtr const nTicks,
+    QTimeEvtCtr const interval,
+    QTimeEvtCtr const slack)
+{
+    // the batch boundaries are multiples of the largest power of 2,
+    // which does not exceed (slack + 1), see NOTE3
+    QTimeEvtCtr mask = 0U;
+    while ((mask < slack) && ((QTimeEvtCtr)((mask << 1U) | 1U) <= slack)) {
+        mask = (QTimeEvtCtr)((mask << 1U) | 1U);
+    }
+
+    QF_CRIT_STAT
+    QTE_LOCK_(QTE_SHARD_(me));
+    QF_MEM_SYS();
+    me->slackMask = mask; // the slack applies also to rearming
+    QF_MEM_APP();
+    QTE_UNLOCK_(QTE_SHARD_(me));
+
+    QTimeEvt_armX(me, nTicks, interval);
 }
+#endif // def QTIMEEVT_SLACK
 
 //${QF::QTimeEvt::disarm} ....................................................
 //! @public @memberof QTimeEvt
@@ -160,11 +370,16 @@ bool QTimeEvt_disarm(QTimeEvt * const me) {
     #endif
 
     QF_CRIT_STAT
-    QF_CRIT_ENTRY();
+    QTE_LOCK_(QTE_SHARD_(me));
     QF_MEM_SYS();
 
+    #ifdef QTIMEEVT_TICKLESS_SYNC_
+    QTIMEEVT_TICKLESS_SYNC_(); // credit the elapsed ticks, see NOTE1
+    #endif
+
     // is the time event actually armed?
     bool wasArmed;
+    QTE_QS_CRIT_ENTRY_();
     if (me->ctr != 0U) {
         wasArmed = true;
         me->super.refCtr_ |= QTE_WAS_DISARMED;
@@ -191,9 +406,10 @@ bool QTimeEvt_disarm(QTimeEvt * const me) {
             QS_U8_PRE_(me->super.refCtr_ & QTE_TICK_RATE); // tick rate
         QS_END_PRE_()
     }
+    QTE_QS_CRIT_EXIT_();
 
     QF_MEM_APP();
-    QF_CRIT_EXIT();
+    QTE_UNLOCK_(QTE_SHARD_(me));
 
     return wasArmed;
 }
@@ -210,7 +426,7 @@ bool QTimeEvt_rearm(QTimeEvt * const me,
     #endif
 
     QF_CRIT_STAT
-    QF_CRIT_ENTRY();
+    QTE_LOCK_(QTE_SHARD_(me));
     QF_MEM_SYS();
 
     Q_REQUIRE_INCRIT(600, (me->act != (void *)0)
@@ -218,6 +434,10 @@ bool QTimeEvt_rearm(QTimeEvt * const me,
         && (nTicks != 0U)
         && (me->super.sig >= (QSignal)Q_USER_SIG));
 
+    #ifdef QTIMEEVT_TICKLESS_SYNC_
+    QTIMEEVT_TICKLESS_SYNC_(); // credit the elapsed ticks, see NOTE1
+    #endif
+
     // is the time evt not running?
     bool wasArmed;
     if (me->ctr == 0U) {
@@ -239,9 +459,11 @@ bool QTimeEvt_rearm(QTimeEvt * const me,
             // armed" list is appended to the main list of armed time events
             // based on QTimeEvt_timeEvtHead_[tickRate].next. Again, this is
             // to keep any changes to the main list exclusively inside the
-            // QTimeEvt_tick_().
-            me->next = (QTimeEvt *)QTimeEvt_timeEvtHead_[tickRate].act;
-            QTimeEvt_timeEvtHead_[tickRate].act = me;
+            // QTimeEvt_tick_(). (With QTIMEEVT_SHARDS, the lists of the
+            // shard are used, see NOTE4.)
+            QTimeEvt * const head = QTE_HEAD_(QTE_SHARD_(me), tickRate);
+            me->next = (QTimeEvt *)head->act;
+            head->act = me;
         }
     }
     else { // the time event was armed
@@ -249,6 +471,13 @@ bool QTimeEvt_rearm(QTimeEvt * const me,
     }
     me->ctr = nTicks; // re-load the tick counter (shift the phasing)
 
+    #ifdef QTIMEEVT_SLACK
+    // delay the expiry to the nearest batch boundary, see NOTE3
+    me->ctr = QTimeEvt_align_(QTE_HEAD_(QTE_SHARD_(me), tickRate)->interval,
+                              nTicks, me->slackMask);
+    #endif
+
+    QTE_QS_CRIT_ENTRY_();
     QS_BEGIN_PRE_(QS_QF_TIMEEVT_REARM, qs_id)
         QS_TIME_PRE_();            // timestamp
         QS_OBJ_PRE_(me);           // this time event object
@@ -257,9 +486,10 @@ bool QTimeEvt_rearm(QTimeEvt * const me,
         QS_TEC_PRE_(me->interval); // the interval
         QS_2U8_PRE_(tickRate, (wasArmed ? 1U : 0U));
     QS_END_PRE_()
+    QTE_QS_CRIT_EXIT_();
 
     QF_MEM_APP();
-    QF_CRIT_EXIT();
+    QTE_UNLOCK_(QTE_SHARD_(me));
 
     return wasArmed;
 }
@@ -268,14 +498,14 @@ bool QTimeEvt_rearm(QTimeEvt * const me,
 //! @public @memberof QTimeEvt
 bool QTimeEvt_wasDisarmed(QTimeEvt * const me) {
     QF_CRIT_STAT
-    QF_CRIT_ENTRY();
+    QTE_LOCK_(QTE_SHARD_(me));
     QF_MEM_SYS();
 
     uint8_t const wasDisarmed = (me->super.refCtr_ & QTE_WAS_DISARMED);
     me->super.refCtr_ |= QTE_WAS_DISARMED; // mark as disarmed
 
     QF_MEM_APP();
-    QF_CRIT_EXIT();
+    QTE_UNLOCK_(QTE_SHARD_(me));
 
     return wasDisarmed != 0U;
 }
@@ -283,19 +513,86 @@ bool QTimeEvt_wasDisarmed(QTimeEvt * const me) {
 //${QF::QTimeEvt::currCtr} ...................................................
 //! @public @memberof QTimeEvt
 QTimeEvtCtr QTimeEvt_currCtr(QTimeEvt const * const me) {
+    QF_CRIT_STAT
+    QTE_LOCK_(QTE_SHARD_(me));
+    QTimeEvtCtr ctr = me->ctr;
+
+    #ifdef QTIMEEVT_TICKLESS_ELAPSED_
+    if (ctr != 0U) { // armed?
+        // account for the ticks not credited yet, see NOTE1
+        QTimeEvtCtr const n = QTIMEEVT_TICKLESS_ELAPSED_();
+        ctr = (n < ctr) ? (QTimeEvtCtr)(ctr - n) : 1U;
+    }
+    #endif
+
+    QTE_UNLOCK_(QTE_SHARD_(me));
+
+    return ctr;
+}
+
+//${QF::QTimeEvt::setPolicy} .................................................
+#ifdef QTIMEEVT_POST_POLICY
+//! @public @memberof QTimeEvt
+void QTimeEvt_setPolicy(QTimeEvt * const me,
+    enum QTimeEvtPolicy const policy)
+{
+    QF_CRIT_STAT
+    QTE_LOCK_(QTE_SHARD_(me));
+    QF_MEM_SYS();
+
+    Q_REQUIRE_INCRIT(700, policy <= QTIMEEVT_POLICY_RETRY);
+
+    me->super.refCtr_ = (uint8_t)((me->super.refCtr_ & ~QTE_POLICY & 0xFFU)
+                        | ((uint_fast8_t)policy << QTE_POLICY_SHIFT));
+
+    QF_MEM_APP();
+    QTE_UNLOCK_(QTE_SHARD_(me));
+}
+#endif // def QTIMEEVT_POST_POLICY
+
+//${QF::QTimeEvt::getNDropped} ...............................................
+#ifdef QTIMEEVT_POST_POLICY
+//! @static @public @memberof QTimeEvt
+uint32_t QTimeEvt_getNDropped(uint_fast8_t const tickRate) {
     QF_CRIT_STAT
     QF_CRIT_ENTRY();
-    QTimeEvtCtr const ctr = me->ctr;
+    Q_REQUIRE_INCRIT(710, tickRate < QF_MAX_TICK_RATE);
+    uint32_t const n = l_nDropped[tickRate];
     QF_CRIT_EXIT();
 
-    return ctr;
+    return n;
+}
+#endif // def QTIMEEVT_POST_POLICY
+
+//${QF::QTimeEvt::getNRetried} ...............................................
+#ifdef QTIMEEVT_POST_POLICY
+//! @static @public @memberof QTimeEvt
+uint32_t QTimeEvt_getNRetried(uint_fast8_t const tickRate) {
+    QF_CRIT_STAT
+    QF_CRIT_ENTRY();
+    Q_REQUIRE_INCRIT(720, tickRate < QF_MAX_TICK_RATE);
+    uint32_t const n = l_nRetried[tickRate];
+    QF_CRIT_EXIT();
+
+    return n;
 }
+#endif // def QTIMEEVT_POST_POLICY
 
 //${QF::QTimeEvt::tick_} .....................................................
 //! @static @private @memberof QTimeEvt
 void QTimeEvt_tick_(
     uint_fast8_t const tickRate,
     void const * const sender)
+{
+    QTimeEvt_tickN_(tickRate, 1U, sender);
+}
+
+//${QF::QTimeEvt::tickN_} ....................................................
+//! @static @private @memberof QTimeEvt
+void QTimeEvt_tickN_(
+    uint_fast8_t const tickRate,
+    QTimeEvtCtr const nTicks,
+    void const * const sender)
 {
     #ifndef Q_SPY
     Q_UNUSED_PAR(sender);
@@ -305,128 +602,262 @@ void QTimeEvt_tick_(
     QF_CRIT_ENTRY();
     QF_MEM_SYS();
 
-    Q_REQUIRE_INCRIT(100, tickRate < Q_DIM(QTimeEvt_timeEvtHead_));
+    Q_REQUIRE_INCRIT(100, (tickRate < Q_DIM(QTimeEvt_timeEvtHead_))
+        && (nTicks != 0U));
 
-    QTimeEvt *prev = &QTimeEvt_timeEvtHead_[tickRate];
+    #ifdef QTIMEEVT_SLACK
+    // the tick count after this call (for aligning the periodic expiries)
+    QTimeEvtCtr const now
+        = (QTimeEvtCtr)(QTimeEvt_timeEvtHead_[tickRate].interval + nTicks);
+    #endif
 
     QS_BEGIN_PRE_(QS_QF_TICK, 0U)
-        ++prev->ctr;
-        QS_TEC_PRE_(prev->ctr);   // tick ctr
+        QTimeEvt_timeEvtHead_[tickRate].ctr += nTicks;
+        QS_TEC_PRE_(QTimeEvt_timeEvtHead_[tickRate].ctr); // tick ctr
         QS_U8_PRE_(tickRate);     // tick rate
     QS_END_PRE_()
 
+    #ifdef QTIMEEVT_SHARDS
+    #ifdef QTIMEEVT_SLACK
+    QTimeEvt_timeEvtHead_[tickRate].interval = now; // the same in all shards
+    #endif
+    QF_MEM_APP();
+    QF_CRIT_EXIT(); // the shards are walked under their own locks, see NOTE4
+    #endif
+
+    // scan the linked-lists of time events at this rate (one per shard)...
+    for (uint_fast8_t shard = 0U; shard < QTE_SHARDS_; ++shard) {
+    #ifdef QTIMEEVT_SHARDS
+        QTE_LOCK_(shard);
+        QF_MEM_SYS();
+    #endif
+        QTimeEvt * const head = QTE_HEAD_(shard, tickRate);
+        QTimeEvt *prev = head;
+
+        uint_fast8_t limit = 2U*QF_MAX_ACTIVE; // loop hard limit
+        for (; limit > 0U; --limit) {
+            QTimeEvt *e = prev->next; // advance down the time evt. list
+
+            if (e == (QTimeEvt *)0) { // end of the list?
+
+                // any new time events armed since the last QTimeEvt_tick_()?
+                if (head->act != (void *)0) {
+
+                    // sanity check
+                    Q_ASSERT_INCRIT(110, prev != (QTimeEvt *)0);
+                    prev->next = (QTimeEvt *)head->act;
+                    head->act = (void *)0;
+                    e = prev->next; // switch to the new list
+                }
+                else { // all currently armed time events are processed
+                    break; // terminate the for-loop
+                }
+            }
+
+            // the time event 'e' must be valid
+            Q_ASSERT_INCRIT(112, QEvt_verify_(Q_EVT_CAST(QEvt)));
+
+            if (e->ctr == 0U) { // time event scheduled for removal?
+                prev->next = e->next;
+                // mark time event 'e' as NOT linked
+                e->super.refCtr_ &= (uint8_t)(~QTE_IS_LINKED & 0xFFU);
+                // do NOT advance the prev pointer
+                QF_MEM_APP();
+                QTE_UNLOCK_(shard); // exit crit. section to reduce latency
+
+                // NOTE: prevent merging critical sections
+                // In some QF ports the critical section exit takes effect
+                // only on the next machine instruction. If the next
+                // instruction is another entry to a critical section, the
+                // critical section might not be really exited, but rather
+                // the two adjacent critical sections would be MERGED.
+                // The QF_CRIT_EXIT_NOP() macro contains minimal code required
+                // to prevent such merging of critical sections in QF ports,
+                // in which it can occur.
+                QF_CRIT_EXIT_NOP();
+            }
+            else {
+                if (e->ctr <= nTicks) { // does time event expire in nTicks?
+                    QActive * const act = (QActive *)e->act;
+
+                    if (e->interval != 0U) { // periodic time evt?
+                        // rearm the time event in phase with its last expiry
+                        // (multiple expiries within nTicks are coalesced
+                        // into a single post, see NOTE2)
+                        e->ctr = (QTimeEvtCtr)(e->interval
+                            - ((QTimeEvtCtr)(nTicks - e->ctr) % e->interval));
+    #ifdef QTIMEEVT_SLACK
+                        // delay to the nearest batch boundary, see NOTE3
+                        e->ctr = QTimeEvt_align_(now, e->ctr, e->slackMask);
+    #endif
+                        prev = e; // advance to this time event
+                    }
+                    else { // one-shot time event: automatically disarm
+                        e->ctr = 0U;
+                        prev->next = e->next;
+
+                        // mark time event 'e' as NOT linked
+                        e->super.refCtr_ &= (uint8_t)(~QTE_IS_LINKED & 0xFFU);
+                        // do NOT advance the prev pointer
+
+                        QTE_QS_CRIT_ENTRY_();
+                        QS_BEGIN_PRE_(QS_QF_TIMEEVT_AUTO_DISARM, act->prio)
+                            QS_OBJ_PRE_(e);        // this time event object
+                            QS_OBJ_PRE_(act);      // the target AO
+                            QS_U8_PRE_(tickRate);  // tick rate
+                        QS_END_PRE_()
+                        QTE_QS_CRIT_EXIT_();
+                    }
+
+                    QTE_QS_CRIT_ENTRY_();
+                    QS_BEGIN_PRE_(QS_QF_TIMEEVT_POST, act->prio)
+                        QS_TIME_PRE_();            // timestamp
+                        QS_OBJ_PRE_(e);            // the time event object
+                        QS_SIG_PRE_(e->super.sig); // signal of this time evt
+                        QS_OBJ_PRE_(act);          // the target AO
+                        QS_U8_PRE_(tickRate);      // tick rate
+                    QS_END_PRE_()
+                    QTE_QS_CRIT_EXIT_();
+
+    #ifdef QXK_H_
+                    if (e->super.sig < Q_USER_SIG) {
+                        QXThread_timeout_(act);
+                        QF_MEM_APP();
+                        QF_CRIT_EXIT();
+                    }
+                    else {
+                        QF_MEM_APP();
+                        QF_CRIT_EXIT(); // exit crit. section before posting
+
+    #ifdef QTIMEEVT_POST_POLICY
+                        // deliver according to the policy, see NOTE5
+                        QTimeEvt_post_(e, act, tickRate, nTicks, sender);
+    #else
+                        // QACTIVE_POST() asserts if the queue overflows
+                        QACTIVE_POST(act, &e->super, sender);
+    #endif
+                    }
+    #else
+                    QF_MEM_APP();
+                    QTE_UNLOCK_(shard); // exit crit. section before posting
+
+    #ifdef QTIMEEVT_POST_POLICY
+                    // deliver according to the policy, see NOTE5
+                    QTimeEvt_post_(e, act, tickRate, nTicks, sender);
+    #else
+                    // QACTIVE_POST() asserts if the queue overflows
+                    QACTIVE_POST(act, &e->super, sender);
+    #endif
+    #endif
+                }
+                else {
+                    e->ctr -= nTicks;
+                    prev = e; // advance to this time event
+                    QF_MEM_APP();
+                    QTE_UNLOCK_(shard); // exit crit. section to reduce latency
+
+                    // prevent merging critical sections, see NOTE above
+                    QF_CRIT_EXIT_NOP();
+                }
+            }
+            QTE_LOCK_(shard); // re-enter crit. section to continue the loop
+            QF_MEM_SYS();
+        }
+
+        Q_ENSURE_INCRIT(190, limit > 0U);
+
+    #ifdef QTIMEEVT_SLACK
+        // NOTE: the tick count is advanced only after all time events
+        // (including the ones armed during this call) have been processed
+        head->interval = now;
+    #endif
+
+    #ifdef QTIMEEVT_SHARDS
+        QF_MEM_APP();
+        QTE_UNLOCK_(shard);
+    #endif
+    }
+
+    #ifndef QTIMEEVT_SHARDS
+    QF_MEM_APP();
+    QF_CRIT_EXIT();
+    #endif
+}
+
+//${QF::QTimeEvt::nextExpiry_} ...............................................
+//! @static @private @memberof QTimeEvt
+QTimeEvtCtr QTimeEvt_nextExpiry_(uint_fast8_t const tickRate) {
+    // NOTE: this function must be called inside a critical section and
+    // from the same context as QTimeEvt_tick_(), but never concurrently
+    // with it, because it unlinks the disarmed time events.
+    Q_REQUIRE_INCRIT(900, tickRate < QF_MAX_TICK_RATE);
+
+    QTimeEvtCtr min = 0U; // assume no armed time events
+
     // scan the linked-list of time events at this rate...
+    QTimeEvt *prev = &QTimeEvt_timeEvtHead_[tickRate];
     uint_fast8_t limit = 2U*QF_MAX_ACTIVE; // loop hard limit
     for (; limit > 0U; --limit) {
-        QTimeEvt *e = prev->next; // advance down the time evt. list
+        QTimeEvt * const e = prev->next; // advance down the time evt. list
 
         if (e == (QTimeEvt *)0) { // end of the list?
 
             // any new time events armed since the last QTimeEvt_tick_()?
             if (QTimeEvt_timeEvtHead_[tickRate].act != (void *)0) {
-
-                // sanity check
-                Q_ASSERT_INCRIT(110, prev != (QTimeEvt *)0);
                 prev->next = (QTimeEvt *)QTimeEvt_timeEvtHead_[tickRate].act;
                 QTimeEvt_timeEvtHead_[tickRate].act = (void *)0;
-                e = prev->next; // switch to the new list
             }
             else { // all currently armed time events are processed
                 break; // terminate the for-loop
             }
         }
-
-        // the time event 'e' must be valid
-        Q_ASSERT_INCRIT(112, QEvt_verify_(Q_EVT_CAST(QEvt)));
-
-        if (e->ctr == 0U) { // time event scheduled for removal?
+        else if (e->ctr == 0U) { // time event scheduled for removal?
             prev->next = e->next;
             // mark time event 'e' as NOT linked
             e->super.refCtr_ &= (uint8_t)(~QTE_IS_LINKED & 0xFFU);
             // do NOT advance the prev pointer
-            QF_MEM_APP();
-            QF_CRIT_EXIT(); // exit crit. section to reduce latency
-
-            // NOTE: prevent merging critical sections
-            // In some QF ports the critical section exit takes effect only
-            // on the next machine instruction. If the next instruction is
-            // another entry to a critical section, the critical section
-            // might not be really exited, but rather the two adjacent
-            // critical sections would be MERGED. The QF_CRIT_EXIT_NOP()
-            // macro contains minimal code required to prevent such merging
-            // of critical sections in QF ports, in which it can occur.
-            QF_CRIT_EXIT_NOP();
         }
         else {
-            --e->ctr;
-
-            if (e->ctr == 0U) { // is time event about to expire?
-                QActive * const act = (QActive *)e->act;
-
-                if (e->interval != 0U) { // periodic time evt?
-                    e->ctr = e->interval; // rearm the time event
-                    prev = e; // advance to this time event
-                }
-                else { // one-shot time event: automatically disarm
-                    prev->next = e->next;
-
-                    // mark time event 'e' as NOT linked
-                    e->super.refCtr_ &= (uint8_t)(~QTE_IS_LINKED & 0xFFU);
-                    // do NOT advance the prev pointer
-
-                    QS_BEGIN_PRE_(QS_QF_TIMEEVT_AUTO_DISARM, act->prio)
-                        QS_OBJ_PRE_(e);        // this time event object
-                        QS_OBJ_PRE_(act);      // the target AO
-                        QS_U8_PRE_(tickRate);  // tick rate
-                    QS_END_PRE_()
-                }
-
-                QS_BEGIN_PRE_(QS_QF_TIMEEVT_POST, act->prio)
-                    QS_TIME_PRE_();            // timestamp
-                    QS_OBJ_PRE_(e);            // the time event object
-                    QS_SIG_PRE_(e->super.sig); // signal of this time event
-                    QS_OBJ_PRE_(act);          // the target AO
-                    QS_U8_PRE_(tickRate);      // tick rate
-                QS_END_PRE_()
-
-    #ifdef QXK_H_
-                if (e->super.sig < Q_USER_SIG) {
-                    QXThread_timeout_(act);
-                    QF_MEM_APP();
-                    QF_CRIT_EXIT();
-                }
-                else {
-                    QF_MEM_APP();
-                    QF_CRIT_EXIT(); // exit crit. section before posting
-
-                    // QACTIVE_POST() asserts if the queue overflows
-                    QACTIVE_POST(act, &e->super, sender);
-                }
-    #else
-                QF_MEM_APP();
-                QF_CRIT_EXIT(); // exit crit. section before posting
-
-                // QACTIVE_POST() asserts if the queue overflows
-                QACTIVE_POST(act, &e->super, sender);
-    #endif
+            if ((min == 0U) || (e->ctr < min)) {
+                min = e->ctr; // the earliest expiry so far
             }
-            else {
-                prev = e; // advance to this time event
+            prev = e; // advance to this time event
+        }
+    }
+    Q_ENSURE_INCRIT(910, limit > 0U);
 
-                QF_MEM_APP();
-                QF_CRIT_EXIT(); // exit crit. section to reduce latency
+    return min;
+}
 
-                // prevent merging critical sections, see NOTE above
-                QF_CRIT_EXIT_NOP();
+//${QF::QTimeEvt::credit_} ...................................................
+//! @static @private @memberof QTimeEvt
+void QTimeEvt_credit_(
+    uint_fast8_t const tickRate,
+    QTimeEvtCtr const nTicks)
+{
+    // NOTE: this function must be called inside a critical section.
+    // The credited ticks must not expire any time event, which means that
+    // nTicks must be lower than QTimeEvt_nextExpiry_(tickRate).
+    Q_REQUIRE_INCRIT(920, tickRate < QF_MAX_TICK_RATE);
+
+    for (uint_fast8_t lst = 0U; lst < 2U; ++lst) {
+        uint_fast8_t limit = 2U*QF_MAX_ACTIVE; // loop hard limit
+        QTimeEvt *e = (lst == 0U)
+                      ? QTimeEvt_timeEvtHead_[tickRate].next
+                      : (QTimeEvt *)QTimeEvt_timeEvtHead_[tickRate].act;
+        for (; (e != (QTimeEvt *)0) && (limit > 0U); --limit) {
+            if (e->ctr != 0U) { // armed?
+                Q_ASSERT_INCRIT(930, e->ctr > nTicks);
+                e->ctr -= nTicks;
             }
+            e = e->next;
         }
-        QF_CRIT_ENTRY(); // re-enter crit. section to continue the loop
-        QF_MEM_SYS();
+        Q_ENSURE_INCRIT(940, limit > 0U);
     }
 
-    Q_ENSURE_INCRIT(190, limit > 0U);
-    QF_MEM_APP();
-    QF_CRIT_EXIT();
+    #ifdef QTIMEEVT_SLACK
+    QTimeEvt_timeEvtHead_[tickRate].interval += nTicks; // advance tick count
+    #endif
 }
 
 //${QF::QTimeEvt::noActive} ..................................................
@@ -437,16 +868,96 @@ bool QTimeEvt_noActive(uint_fast8_t const tickRate) {
     Q_REQUIRE_INCRIT(800, tickRate < QF_MAX_TICK_RATE);
     QF_CRIT_EXIT();
 
-    bool inactive;
-    if (QTimeEvt_timeEvtHead_[tickRate].next != (QTimeEvt *)0) {
-        inactive = false;
-    }
-    else if ((QTimeEvt_timeEvtHead_[tickRate].act != (void *)0)) {
-        inactive = false;
-    }
-    else {
-        inactive = true;
+    bool inactive = true;
+    for (uint_fast8_t shard = 0U; shard < QTE_SHARDS_; ++shard) {
+        QTimeEvt const * const head = QTE_HEAD_(shard, tickRate);
+        if (head->next != (QTimeEvt *)0) {
+            inactive = false;
+        }
+        else if ((head->act != (void *)0)) {
+            inactive = false;
+        }
+        else {
+            // this shard is inactive
+        }
     }
     return inactive;
 }
 //$enddef${QF::QTimeEvt} ^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^
+
+//============================================================================
+// NOTE1:
+// In the tickless (dynamic-tick) mode, the QF port does not call
+// QTimeEvt_tick_() periodically. Instead, the port sleeps until the earliest
+// expiry reported by QTimeEvt_nextExpiry_() and credits the ticks elapsed in
+// the meantime in bulk with QTimeEvt_credit_(). The port signals its support
+// for the tickless mode by defining the macros:
+// - QTIMEEVT_TICKLESS_SYNC_() called inside the critical section before any
+//   change of a time event. It credits the ticks elapsed so far, so that the
+//   counters of all time events stay relative to the same last tick, and
+//   wakes up the ticker to re-evaluate the next deadline.
+// - QTIMEEVT_TICKLESS_ELAPSED_() returns the number of ticks elapsed, but
+//   not yet credited, which QTimeEvt_currCtr() subtracts from the counter.
+//
+// NOTE2:
+// QTimeEvt_tickN_() processes nTicks clock ticks in a single pass over the
+// time event list, which is used to catch up with the ticks missed due to
+// a scheduling delay (e.g., in QTicker or in the POSIX tickers). A one-shot
+// time event expiring within nTicks is posted once and disarmed. A periodic
+// time event expiring (possibly several times) within nTicks is posted only
+// once, and its counter is re-armed in phase with the last of its expiries,
+// so that the subsequent expiries stay aligned with the original period.
+// QTimeEvt_tick_() is equivalent to QTimeEvt_tickN_() with nTicks == 1.
+//
+// NOTE3:
+// With QTIMEEVT_SLACK defined, a time event armed by QTimeEvt_armSlack()
+// may expire up to 'slack' ticks later than requested. The framework uses
+// this freedom to delay the expiry to the nearest "batch boundary", which
+// is a multiple of the largest power of 2 not exceeding (slack + 1) in the
+// tick count of the given tick rate. Time events with similar slack then
+// expire at the same ticks, which batches the posting (and the wakeups
+// of the AO threads). The slack stays with the time event and applies also
+// to QTimeEvt_rearm() and to every periodic expiry, so each period can be
+// longer than the interval by up to 'slack' ticks. An expiry is never
+// earlier than requested. The tick count is kept in the otherwise unused
+// 'interval' attribute of QTimeEvt_timeEvtHead_[tickRate].
+//
+// NOTE4:
+// By default, all time events of a tick rate are in one list in
+// QTimeEvt_timeEvtHead_[tickRate], which is protected by the critical
+// section. In the POSIX ports, every critical section is a lock/unlock of
+// the global mutex, so arming/disarming time events (e.g., request timeouts)
+// contends with all other threads and with the tick walk. With
+// QTIMEEVT_SHARDS defined, the time events are distributed over
+// QTIMEEVT_SHARDS separate lists (shards) per tick rate by the priority of
+// the owning AO (prio % QTIMEEVT_SHARDS). Every shard is protected by its own
+// lock QTIMEEVT_SHARD_LOCK_()/QTIMEEVT_SHARD_UNLOCK_() provided by the
+// QF port, which the time event operations take instead of the critical
+// section. QTimeEvt_tickN_() walks the shards one after another, each under
+// its own lock, so the AOs of different shards never contend with each
+// other. The data shared by all shards (the QS trace buffer and the
+// counters of the delivery policy) are accessed in the critical section,
+// which is nested inside the shard lock (never the other way around).
+// QTimeEvt_timeEvtHead_[tickRate] still holds the tick counter (and the
+// tick count of QTIMEEVT_SLACK), but its lists are not used.
+//
+// NOTE5:
+// With QTIMEEVT_POST_POLICY defined, every time event has a delivery policy
+// (QTimeEvt_setPolicy(), stored in the otherwise unused bits of refCtr_),
+// which QTimeEvt_tickN_() applies when the expired time event cannot be
+// posted, because the queue of the target AO is full:
+// - QTIMEEVT_POLICY_ASSERT (default) posts with QACTIVE_POST() and asserts,
+//   as without QTIMEEVT_POST_POLICY;
+// - QTIMEEVT_POLICY_DROP posts with a margin, so the expiry is lost, counted
+//   (QTimeEvt_getNDropped()) and traced (QS_QF_TIMEEVT_POST_DROP). The time
+//   event itself is disarmed (one-shot) or re-armed (periodic) as usual;
+// - QTIMEEVT_POLICY_RETRY keeps the time event armed to expire again on
+//   the next tick, which is counted (QTimeEvt_getNRetried()) and traced
+//   (QS_QF_TIMEEVT_POST_RETRY). A periodic time event continues in phase
+//   with the retried expiry. A one-shot time event re-armed (or a periodic
+//   time event disarmed) by the application between the failed posting
+//   and the retry decision is not retried, but counted as dropped.
+//   Under a sustained overload, the retried time events compete for the
+//   freed queue entries in the order of the time event list.
+// The policy is reset to QTIMEEVT_POLICY_ASSERT by QTimeEvt_ctorX().
+//
@@ -264,6 +264,7 @@ void QK_activate_(void) {
 
         // dispatch event (virtual call)
         (*a->super.vptr->dispatch)(&a->super, e, p);
+        QACTIVE_RTC_END_(a);
     #if (QF_MAX_EPOOL > 0U)
         QF_gc(e);
     #endif
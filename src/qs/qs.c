@@ -160,6 +160,134 @@ QS_Filter QS_filt_;
 //! @static @private @memberof QS
 QS_Attr QS_priv_;
 
+#ifdef QS_OVERFLOW_POLICY
+// QS buffer overflow accounting (see QS_OVERFLOW_POLICY in qp_config.h)
+static struct {
+    uint32_t nOverrun;      // # bytes of the old data overwritten
+    uint32_t nDropped[128]; // # dropped records of each type
+    uint8_t *buf;           // the QS buffer while a record is dropped
+    QSCtr head;             // the QS buffer head while a record is dropped
+    QSCtr used;             // # bytes used while a record is dropped
+    QSCtr end;              // the QS buffer end while a record is dropped
+    uint8_t rec;            // the record being dropped
+    uint8_t next;           // next record type to report in QS_OVERFLOW
+    bool changed;           // any counters changed since the last report?
+    bool report;            // QS_OVERFLOW report in progress?
+} l_ovf;
+
+// the dropped record is produced into this scratch space
+static uint8_t l_ovfSink[16];
+
+// max # (record-type, count) pairs in one QS_OVERFLOW record, such that
+// the record (at most 32 bytes without the pairs) fits in QS_REC_MAX
+#define QS_OVF_PAIRS_ ((QS_REC_MAX - 32U) / 10U)
+#endif // def QS_OVERFLOW_POLICY
+
+#if (defined QS_OVERFLOW_POLICY) && (QS_OVERFLOW_POLICY != 0U)
+// space [bytes] reserved for the end of every record
+// (the escaped checksum and QS_FRAME, or the CRC of the fast record)
+#define QS_REC_END_ 4U
+
+// room [bytes] left in the current record for the data, which still
+// needs 'extra' bytes (such as the format and the string terminator),
+// so that the record does not exceed QS_REC_MAX
+static QSCtr QS_recRoom_(QSCtr const used, QSCtr const extra) {
+    QSCtr const len = (QSCtr)(used - QS_TX_.recBeg) + extra + QS_REC_END_;
+    return (len < (QSCtr)QS_REC_MAX)
+           ? (QSCtr)((QSCtr)QS_REC_MAX - len)
+           : 0U;
+}
+#define QS_REC_ROOM_(used_, extra_) QS_recRoom_((used_), (extra_))
+#else
+#define QS_REC_ROOM_(used_, extra_) ((QSCtr)~0U)
+#endif
+
+#ifdef QS_SMP_MAX
+// sampling and rate limits of the records (see QS_SMP_MAX in qp_config.h)
+static struct {
+    uint16_t nth;        // pass 1 in 'nth' records (0 or 1: all records)
+    uint16_t cnt;        // # records since the last passed record
+    uint8_t rec;         // the record type
+    uint8_t rate;        // tokens added in QS_SMP_TICK() (0: no refill)
+    uint8_t burst;       // max tokens (0: no rate limit)
+    uint8_t tok[128];    // tokens available for each QS-ID
+} l_smp[QS_SMP_MAX];
+
+// is the sampling slot 'i' in use?
+#define QS_SMP_USED_(i_) ((l_smp[i_].nth > 1U) || (l_smp[i_].burst != 0U))
+#endif // def QS_SMP_MAX
+
+#ifdef QS_FAST_FRAMING
+#ifdef QS_FAST_CRC
+// CRC-16/CCITT-FALSE (polynomial 0x1021) of 'n' bytes at 'p',
+// computed four bits at a time
+static uint16_t QS_crc16_(
+    uint16_t crc,
+    uint8_t const * p,
+    uint_fast32_t n)
+{
+    static uint16_t const crcTab[16] = {
+        0x0000U, 0x1021U, 0x2042U, 0x3063U, 0x4084U, 0x50A5U, 0x60C6U, 0x70E7U,
+        0x8108U, 0x9129U, 0xA14AU, 0xB16BU, 0xC18CU, 0xD1ADU, 0xE1CEU, 0xF1EFU
+    };
+    for (; n != 0U; --n) {
+        crc = (uint16_t)((uint16_t)(crc << 4U)
+                         ^ crcTab[(crc >> 12U) ^ (*p >> 4U)]);
+        crc = (uint16_t)((uint16_t)(crc << 4U)
+                         ^ crcTab[(crc >> 12U) ^ (*p & 0x0FU)]);
+        ++p;
+    }
+    return crc;
+}
+#endif // def QS_FAST_CRC
+
+// finish the fast record: append the CRC (if configured) and fill in
+// the record length at the beginning of the record
+static void QS_fastEnd_(
+    uint8_t * const buf,
+    QSCtr * const pHead,
+    QSCtr const end)
+{
+    QSCtr head = *pHead;     // put in a temporary (register)
+    QSCtr pos  = QS_TX_.recHead; // position of the 2-byte length
+    uint_fast32_t start = (uint_fast32_t)pos + 2U; // the sequence number
+    if (start >= end) {
+        start -= end;
+    }
+
+    #ifdef QS_FAST_CRC
+    // the CRC covers the record without the sequence number, so that
+    // the records can be re-numbered without recomputing the CRC
+    uint_fast32_t rec = start + 1U;
+    if (rec == end) {
+        rec = 0U;
+    }
+    uint16_t crc = 0xFFFFU;
+    if (head >= rec) { // the record contiguous?
+        crc = QS_crc16_(crc, &buf[rec], head - rec);
+    }
+    else { // the record wraps around the end of the buffer
+        crc = QS_crc16_(crc, &buf[rec], end - rec);
+        crc = QS_crc16_(crc, &buf[0], head);
+    }
+    QS_TX_.used += 2U; // 2 bytes of the CRC about to be added
+    QS_INSERT_BLOCK_(&crc, 2U)
+    #endif // def QS_FAST_CRC
+
+    uint_fast32_t const len = (head >= start)
+                              ? (head - start)
+                              : ((end - start) + head);
+    buf[pos] = (uint8_t)len;
+    ++pos;
+    if (pos == end) {
+        pos = 0U;
+    }
+    buf[pos] = (uint8_t)(len >> 8U);
+
+    *pHead = head;
+}
+#endif // def QS_FAST_FRAMING
+
 //............................................................................
 void QS_glbFilter_(int_fast16_t const filter) {
     bool const isRemove = (filter < 0);
@@ -211,11 +339,13 @@ void QS_glbFilter_(int_fast16_t const filter) {
                 QS_filt_.glb[1] &= (uint8_t)(~0xFCU & 0xFFU);
                 QS_filt_.glb[2] &= (uint8_t)(~0x07U & 0xFFU);
                 QS_filt_.glb[5] &= (uint8_t)(~0x20U & 0xFFU);
+                QS_filt_.glb[10] &= (uint8_t)(~0x06U & 0xFFU);
             }
             else {
                 QS_filt_.glb[1] |= 0xFCU;
                 QS_filt_.glb[2] |= 0x07U;
                 QS_filt_.glb[5] |= 0x20U;
+                QS_filt_.glb[10] |= 0x06U;
             }
             break;
         case (uint8_t)QS_EQ_RECORDS:
@@ -255,9 +385,11 @@ void QS_glbFilter_(int_fast16_t const filter) {
         case (uint8_t)QS_TE_RECORDS:
             if (isRemove) {
                 QS_filt_.glb[4] &= (uint8_t)(~0x3FU & 0xFFU);
+                QS_filt_.glb[10] &= (uint8_t)(~0x18U & 0xFFU);
             }
             else {
                 QS_filt_.glb[4] |= 0x3FU;
+                QS_filt_.glb[10] |= 0x18U;
             }
             break;
         case (uint8_t)QS_SC_RECORDS:
@@ -426,33 +558,66 @@ void QS_locFilter_(int_fast16_t const filter) {
 
 //............................................................................
 void QS_beginRec_(uint_fast8_t const rec) {
-    uint8_t const b = (uint8_t)(QS_priv_.seq + 1U);
+    #ifdef QS_TX_BEGIN_
+    QS_TX_BEGIN_(); // let the QS port prepare the TX buffer
+    #endif
+
+    #if (defined QS_OVERFLOW_POLICY) && (QS_OVERFLOW_POLICY != 0U)
+    // no room for the record in the QS buffer? (drop the newest)
+    if (QS_TX_SHARED_()
+        && ((QSCtr)(QS_priv_.used + QS_REC_MAX) > QS_priv_.end))
+    {
+        // produce the record into the sink and drop it in QS_endRec_()
+        l_ovf.buf  = QS_priv_.buf;
+        l_ovf.head = QS_priv_.head;
+        l_ovf.used = QS_priv_.used;
+        l_ovf.end  = QS_priv_.end;
+        l_ovf.rec  = (uint8_t)rec;
+        QS_priv_.buf  = &l_ovfSink[0];
+        QS_priv_.head = 0U;
+        QS_priv_.used = 0U;
+        QS_priv_.end  = (QSCtr)sizeof(l_ovfSink);
+    }
+    QS_TX_.recBeg = QS_TX_.used; // the record length is limited
+    #endif
+
+    uint8_t const b = (uint8_t)(QS_TX_.seq + 1U);
     uint8_t chksum  = 0U;                // reset the checksum
-    uint8_t * const buf = QS_priv_.buf;  // put in a temporary (register)
-    QSCtr head          = QS_priv_.head; // put in a temporary (register)
-    QSCtr const end     = QS_priv_.end;  // put in a temporary (register)
+    uint8_t * const buf = QS_TX_.buf;    // put in a temporary (register)
+    QSCtr head          = QS_TX_.head;   // put in a temporary (register)
+    QSCtr const end     = QS_TX_.end;    // put in a temporary (register)
+
+    #ifdef QS_FAST_FRAMING
+    QS_TX_.used += 3U; // the sync byte and the 2-byte length
+    QS_INSERT_BYTE_((uint8_t)QS_FAST_SYNC)
+    QS_TX_.recHead = head; // the record length is set in QS_endRec_()
+    QS_INSERT_BYTE_(0U)
+    QS_INSERT_BYTE_(0U)
+    #endif
 
-    QS_priv_.seq = b; // store the incremented sequence num
-    QS_priv_.used += 2U; // 2 bytes about to be added
+    QS_TX_.seq = b; // store the incremented sequence num
+    QS_TX_.used += 2U; // 2 bytes about to be added
 
     QS_INSERT_ESC_BYTE_(b)
 
     chksum = (uint8_t)(chksum + rec); // update checksum
     QS_INSERT_BYTE_((uint8_t)rec) // rec byte does not need escaping
 
-    QS_priv_.head   = head;   // save the head
-    QS_priv_.chksum = chksum; // save the checksum
+    QS_TX_.head   = head;   // save the head
+    QS_TX_.chksum = chksum; // save the checksum
 }
 
 //............................................................................
 void QS_endRec_(void) {
-    uint8_t * const buf = QS_priv_.buf;  // put in a temporary (register)
-    QSCtr   head        = QS_priv_.head;
-    QSCtr const end     = QS_priv_.end;
-    uint8_t b = QS_priv_.chksum;
+    uint8_t * const buf = QS_TX_.buf;    // put in a temporary (register)
+    QSCtr   head        = QS_TX_.head;
+    QSCtr const end     = QS_TX_.end;
+
+    #ifndef QS_FAST_FRAMING
+    uint8_t b = QS_TX_.chksum;
     b ^= 0xFFU;   // invert the bits in the checksum
 
-    QS_priv_.used += 2U; // 2 bytes about to be added
+    QS_TX_.used += 2U; // 2 bytes about to be added
 
     if ((b != QS_FRAME) && (b != QS_ESC)) {
         QS_INSERT_BYTE_(b)
@@ -460,32 +625,60 @@ void QS_endRec_(void) {
     else {
         QS_INSERT_BYTE_(QS_ESC)
         QS_INSERT_BYTE_(b ^ QS_ESC_XOR)
-        ++QS_priv_.used; // account for the ESC byte
+        ++QS_TX_.used; // account for the ESC byte
     }
 
     QS_INSERT_BYTE_(QS_FRAME) // do not escape this QS_FRAME
+    #else // QS_FAST_FRAMING
+    QS_fastEnd_(buf, &head, end); // length (and CRC) of the fast record
+    #endif
 
-    QS_priv_.head = head; // save the head
-
+    QS_TX_.head = head; // save the head
+
+    #if (defined QS_OVERFLOW_POLICY) && (QS_OVERFLOW_POLICY != 0U)
+    // NOTE: the record, which is not dropped, fits in the free space
+    // (QS_REC_MAX) only when it is not longer than QS_REC_MAX. Strings and
+    // memory blocks are truncated to fit, so only a record with too many
+    // fields can be too long (reduce the record or increase QS_REC_MAX).
+    Q_ASSERT_INCRIT(110, (QSCtr)(QS_TX_.used - QS_TX_.recBeg)
+                         <= (QSCtr)QS_REC_MAX);
+
+    if (QS_TX_.buf == &l_ovfSink[0]) { // the record dropped?
+        QS_priv_.buf  = l_ovf.buf; // restore the QS buffer
+        QS_priv_.head = l_ovf.head;
+        QS_priv_.used = l_ovf.used;
+        QS_priv_.end  = l_ovf.end;
+        --QS_priv_.seq; // the dropped record leaves no sequence gap
+        QS_dropRec_(l_ovf.rec);
+    }
+    else
+    #endif
     // overrun over the old data?
-    if (QS_priv_.used > end) {
-        QS_priv_.used = end;   // the whole buffer is used
-        QS_priv_.tail = head;  // shift the tail to the old data
+    if (QS_TX_.used > end) {
+        #ifdef QS_OVERFLOW_POLICY
+        QS_overrun_(QS_TX_.used - end);
+        #endif
+        QS_TX_.used = end;   // the whole buffer is used
+        QS_TX_.tail = head;  // shift the tail to the old data
     }
+
+    #ifdef QS_TX_END_
+    QS_TX_END_(); // let the QS port publish the complete record
+    #endif
 }
 
 //............................................................................
 void QS_u8_raw_(uint8_t const d) {
-    uint8_t chksum = QS_priv_.chksum;    // put in a temporary (register)
-    uint8_t * const buf = QS_priv_.buf;  // put in a temporary (register)
-    QSCtr head          = QS_priv_.head; // put in a temporary (register)
-    QSCtr const end     = QS_priv_.end;  // put in a temporary (register)
+    uint8_t chksum = QS_TX_.chksum;      // put in a temporary (register)
+    uint8_t * const buf = QS_TX_.buf;    // put in a temporary (register)
+    QSCtr head          = QS_TX_.head;   // put in a temporary (register)
+    QSCtr const end     = QS_TX_.end;    // put in a temporary (register)
 
-    QS_priv_.used += 1U; // 1 byte about to be added
+    QS_TX_.used += 1U; // 1 byte about to be added
     QS_INSERT_ESC_BYTE_(d)
 
-    QS_priv_.head   = head;    // save the head
-    QS_priv_.chksum = chksum;  // save the checksum
+    QS_TX_.head   = head;    // save the head
+    QS_TX_.chksum = chksum;  // save the checksum
 }
 
 //............................................................................
@@ -493,53 +686,57 @@ void QS_2u8_raw_(
     uint8_t const d1,
     uint8_t const d2)
 {
-    uint8_t chksum = QS_priv_.chksum;    // put in a temporary (register)
-    uint8_t * const buf = QS_priv_.buf;  // put in a temporary (register)
-    QSCtr head          = QS_priv_.head; // put in a temporary (register)
-    QSCtr const end     = QS_priv_.end;  // put in a temporary (register)
+    uint8_t chksum = QS_TX_.chksum;      // put in a temporary (register)
+    uint8_t * const buf = QS_TX_.buf;    // put in a temporary (register)
+    QSCtr head          = QS_TX_.head;   // put in a temporary (register)
+    QSCtr const end     = QS_TX_.end;    // put in a temporary (register)
 
-    QS_priv_.used += 2U; // 2 bytes are about to be added
+    QS_TX_.used += 2U; // 2 bytes are about to be added
     QS_INSERT_ESC_BYTE_(d1)
     QS_INSERT_ESC_BYTE_(d2)
 
-    QS_priv_.head   = head;    // save the head
-    QS_priv_.chksum = chksum;  // save the checksum
+    QS_TX_.head   = head;    // save the head
+    QS_TX_.chksum = chksum;  // save the checksum
 }
 
 //............................................................................
 void QS_u16_raw_(uint16_t const d) {
-    uint8_t chksum = QS_priv_.chksum;    // put in a temporary (register)
-    uint8_t * const buf = QS_priv_.buf;  // put in a temporary (register)
-    QSCtr head          = QS_priv_.head; // put in a temporary (register)
-    QSCtr const end     = QS_priv_.end;  // put in a temporary (register)
+    uint8_t chksum = QS_TX_.chksum;      // put in a temporary (register)
+    uint8_t * const buf = QS_TX_.buf;    // put in a temporary (register)
+    QSCtr head          = QS_TX_.head;   // put in a temporary (register)
+    QSCtr const end     = QS_TX_.end;    // put in a temporary (register)
     uint16_t x   = d;
 
-    QS_priv_.used += 2U; // 2 bytes are about to be added
+    QS_TX_.used += 2U; // 2 bytes are about to be added
 
     QS_INSERT_ESC_BYTE_((uint8_t)x)
     x >>= 8U;
     QS_INSERT_ESC_BYTE_((uint8_t)x)
 
-    QS_priv_.head   = head;    // save the head
-    QS_priv_.chksum = chksum;  // save the checksum
+    QS_TX_.head   = head;    // save the head
+    QS_TX_.chksum = chksum;  // save the checksum
 }
 
 //............................................................................
 void QS_u32_raw_(uint32_t const d) {
-    uint8_t chksum = QS_priv_.chksum;    // put in a temporary (register)
-    uint8_t * const buf = QS_priv_.buf;  // put in a temporary (register)
-    QSCtr head          = QS_priv_.head; // put in a temporary (register)
-    QSCtr const end     = QS_priv_.end;  // put in a temporary (register)
+    uint8_t chksum = QS_TX_.chksum;      // put in a temporary (register)
+    uint8_t * const buf = QS_TX_.buf;    // put in a temporary (register)
+    QSCtr head          = QS_TX_.head;   // put in a temporary (register)
+    QSCtr const end     = QS_TX_.end;    // put in a temporary (register)
     uint32_t x = d;
 
-    QS_priv_.used += 4U; // 4 bytes are about to be added
+    QS_TX_.used += 4U; // 4 bytes are about to be added
+    #ifdef QS_FAST_FRAMING
+    QS_INSERT_BLOCK_(&x, 4U)
+    #else
     for (uint_fast8_t i = 4U; i != 0U; --i) {
         QS_INSERT_ESC_BYTE_((uint8_t)x)
         x >>= 8U;
     }
+    #endif
 
-    QS_priv_.head   = head;    // save the head
-    QS_priv_.chksum = chksum;  // save the checksum
+    QS_TX_.head   = head;    // save the head
+    QS_TX_.chksum = chksum;  // save the checksum
 }
 
 //............................................................................
@@ -559,23 +756,25 @@ void QS_obj_raw_(void const * const obj) {
 
 //............................................................................
 void QS_str_raw_(char const * const str) {
-    uint8_t chksum = QS_priv_.chksum;    // put in a temporary (register)
-    uint8_t * const buf = QS_priv_.buf;  // put in a temporary (register)
-    QSCtr head          = QS_priv_.head; // put in a temporary (register)
-    QSCtr const end     = QS_priv_.end;  // put in a temporary (register)
-    QSCtr used          = QS_priv_.used; // put in a temporary (register)
-
-    for (char const *s = str; *s != '\0'; ++s) {
+    uint8_t chksum = QS_TX_.chksum;      // put in a temporary (register)
+    uint8_t * const buf = QS_TX_.buf;    // put in a temporary (register)
+    QSCtr head          = QS_TX_.head;   // put in a temporary (register)
+    QSCtr const end     = QS_TX_.end;    // put in a temporary (register)
+    QSCtr used          = QS_TX_.used;   // put in a temporary (register)
+    QSCtr room = QS_REC_ROOM_(used, 1U); // max # chars (truncate the rest)
+
+    for (char const *s = str; (*s != '\0') && (room != 0U); ++s) {
         chksum += (uint8_t)*s; // update checksum
         QS_INSERT_BYTE_((uint8_t)*s)  // ASCII char doesn't need escaping
         ++used;
+        --room;
     }
     QS_INSERT_BYTE_((uint8_t)'\0')  // zero-terminate the string
     ++used;
 
-    QS_priv_.head   = head;   // save the head
-    QS_priv_.chksum = chksum; // save the checksum
-    QS_priv_.used   = used;   // save # of used buffer space
+    QS_TX_.head   = head;   // save the head
+    QS_TX_.chksum = chksum; // save the checksum
+    QS_TX_.used   = used;   // save # of used buffer space
 }
 
 //............................................................................
@@ -583,18 +782,18 @@ void QS_u8_fmt_(
     uint8_t const format,
     uint8_t const d)
 {
-    uint8_t chksum = QS_priv_.chksum;    // put in a temporary (register)
-    uint8_t * const buf = QS_priv_.buf;  // put in a temporary (register)
-    QSCtr   head        = QS_priv_.head; // put in a temporary (register)
-    QSCtr const end     = QS_priv_.end;  // put in a temporary (register)
+    uint8_t chksum = QS_TX_.chksum;      // put in a temporary (register)
+    uint8_t * const buf = QS_TX_.buf;    // put in a temporary (register)
+    QSCtr   head        = QS_TX_.head;   // put in a temporary (register)
+    QSCtr const end     = QS_TX_.end;    // put in a temporary (register)
 
-    QS_priv_.used += 2U; // 2 bytes about to be added
+    QS_TX_.used += 2U; // 2 bytes about to be added
 
     QS_INSERT_ESC_BYTE_(format)
     QS_INSERT_ESC_BYTE_(d)
 
-    QS_priv_.head   = head;   // save the head
-    QS_priv_.chksum = chksum; // save the checksum
+    QS_TX_.head   = head;   // save the head
+    QS_TX_.chksum = chksum; // save the checksum
 }
 
 //............................................................................
@@ -602,21 +801,21 @@ void QS_u16_fmt_(
     uint8_t const format,
     uint16_t const d)
 {
-    uint8_t chksum = QS_priv_.chksum;    // put in a temporary (register)
-    uint8_t * const buf = QS_priv_.buf;  // put in a temporary (register)
-    QSCtr head          = QS_priv_.head; // put in a temporary (register)
-    QSCtr const end     = QS_priv_.end;  // put in a temporary (register)
+    uint8_t chksum = QS_TX_.chksum;      // put in a temporary (register)
+    uint8_t * const buf = QS_TX_.buf;    // put in a temporary (register)
+    QSCtr head          = QS_TX_.head;   // put in a temporary (register)
+    QSCtr const end     = QS_TX_.end;    // put in a temporary (register)
     uint8_t b = (uint8_t)d;
 
-    QS_priv_.used += 3U; // 3 bytes about to be added
+    QS_TX_.used += 3U; // 3 bytes about to be added
 
     QS_INSERT_ESC_BYTE_(format)
     QS_INSERT_ESC_BYTE_(b)
     b = (uint8_t)(d >> 8U);
     QS_INSERT_ESC_BYTE_(b)
 
-    QS_priv_.head   = head;   // save the head
-    QS_priv_.chksum = chksum; // save the checksum
+    QS_TX_.head   = head;   // save the head
+    QS_TX_.chksum = chksum; // save the checksum
 }
 
 //............................................................................
@@ -624,47 +823,53 @@ void QS_u32_fmt_(
     uint8_t const format,
     uint32_t const d)
 {
-    uint8_t chksum = QS_priv_.chksum;    // put in a temporary (register)
-    uint8_t * const buf = QS_priv_.buf;  // put in a temporary (register)
-    QSCtr head          = QS_priv_.head; // put in a temporary (register)
-    QSCtr const end     = QS_priv_.end;  // put in a temporary (register)
+    uint8_t chksum = QS_TX_.chksum;      // put in a temporary (register)
+    uint8_t * const buf = QS_TX_.buf;    // put in a temporary (register)
+    QSCtr head          = QS_TX_.head;   // put in a temporary (register)
+    QSCtr const end     = QS_TX_.end;    // put in a temporary (register)
     uint32_t x = d;
 
-    QS_priv_.used += 5U; // 5 bytes about to be added
+    QS_TX_.used += 5U; // 5 bytes about to be added
     QS_INSERT_ESC_BYTE_(format) // insert the format byte
 
     // insert 4 bytes...
+    #ifdef QS_FAST_FRAMING
+    QS_INSERT_BLOCK_(&x, 4U)
+    #else
     for (uint_fast8_t i = 4U; i != 0U; --i) {
         QS_INSERT_ESC_BYTE_((uint8_t)x)
         x >>= 8U;
     }
+    #endif
 
-    QS_priv_.head   = head;   // save the head
-    QS_priv_.chksum = chksum; // save the checksum
+    QS_TX_.head   = head;   // save the head
+    QS_TX_.chksum = chksum; // save the checksum
 }
 
 //............................................................................
 void QS_str_fmt_(char const * const str) {
-    uint8_t chksum = QS_priv_.chksum;
-    uint8_t * const buf = QS_priv_.buf;  // put in a temporary (register)
-    QSCtr head          = QS_priv_.head; // put in a temporary (register)
-    QSCtr const end     = QS_priv_.end;  // put in a temporary (register)
-    QSCtr used          = QS_priv_.used; // put in a temporary (register)
+    uint8_t chksum = QS_TX_.chksum;
+    uint8_t * const buf = QS_TX_.buf;    // put in a temporary (register)
+    QSCtr head          = QS_TX_.head;   // put in a temporary (register)
+    QSCtr const end     = QS_TX_.end;    // put in a temporary (register)
+    QSCtr used          = QS_TX_.used;   // put in a temporary (register)
+    QSCtr room = QS_REC_ROOM_(used, 2U); // max # chars (truncate the rest)
 
     used += 2U; // account for the format byte and the terminating-0
     QS_INSERT_BYTE_((uint8_t)QS_STR_T)
     chksum += (uint8_t)QS_STR_T;
 
-    for (char const *s = str; *s != '\0'; ++s) {
+    for (char const *s = str; (*s != '\0') && (room != 0U); ++s) {
         QS_INSERT_BYTE_((uint8_t)*s) // ASCII char doesn't need escaping
         chksum += (uint8_t)*s; // update checksum
         ++used;
+        --room;
     }
     QS_INSERT_BYTE_(0U) // zero-terminate the string
 
-    QS_priv_.head   = head;    // save the head
-    QS_priv_.chksum = chksum;  // save the checksum
-    QS_priv_.used   = used;    // save # of used buffer space
+    QS_TX_.head   = head;    // save the head
+    QS_TX_.chksum = chksum;  // save the checksum
+    QS_TX_.used   = used;    // save # of used buffer space
 }
 
 //............................................................................
@@ -672,26 +877,39 @@ void QS_mem_fmt_(
     uint8_t const * const blk,
     uint8_t const size)
 {
-    uint8_t chksum = QS_priv_.chksum;
-    uint8_t * const buf = QS_priv_.buf;  // put in a temporary (register)
-    QSCtr head          = QS_priv_.head; // put in a temporary (register)
-    QSCtr const end     = QS_priv_.end;  // put in a temporary (register)
+    uint8_t chksum = QS_TX_.chksum;
+    uint8_t * const buf = QS_TX_.buf;    // put in a temporary (register)
+    QSCtr head          = QS_TX_.head;   // put in a temporary (register)
+    QSCtr const end     = QS_TX_.end;    // put in a temporary (register)
     uint8_t const *pb   = blk;
 
-    QS_priv_.used += ((QSCtr)size + 2U); // size+2 bytes to be added
+    // max # bytes of the block (truncate the rest): the format byte,
+    // the escaped size, and the bytes escaped (or not in QS_FAST_FRAMING)
+    #ifndef QS_FAST_FRAMING
+    QSCtr const room = QS_REC_ROOM_(QS_TX_.used, 3U) / 2U;
+    #else
+    QSCtr const room = QS_REC_ROOM_(QS_TX_.used, 3U);
+    #endif
+    uint8_t const n = ((QSCtr)size <= room) ? size : (uint8_t)room;
+
+    QS_TX_.used += ((QSCtr)n + 2U); // n+2 bytes to be added
 
     QS_INSERT_BYTE_((uint8_t)QS_MEM_T)
     chksum += (uint8_t)QS_MEM_T;
 
-    QS_INSERT_ESC_BYTE_(size)
-    // output the 'size' # bytes
-    for (uint8_t len = size; len > 0U; --len) {
+    QS_INSERT_ESC_BYTE_(n)
+    // output the 'n' # bytes
+    #ifdef QS_FAST_FRAMING
+    QS_INSERT_BLOCK_(pb, n)
+    #else
+    for (uint8_t len = n; len > 0U; --len) {
         QS_INSERT_ESC_BYTE_(*pb)
         ++pb;
     }
+    #endif
 
-    QS_priv_.head   = head;   // save the head
-    QS_priv_.chksum = chksum; // save the checksum
+    QS_TX_.head   = head;   // save the head
+    QS_TX_.chksum = chksum; // save the checksum
 }
 
 //............................................................................
@@ -700,6 +918,8 @@ void QS_sig_dict_pre_(
     void const * const obj,
     char const * const name)
 {
+    QS_TX_WAIT_(); // wait for room in the QS buffer (if needed)
+
     QS_CRIT_STAT
     QS_CRIT_ENTRY();
     QS_MEM_SYS();
@@ -720,6 +940,8 @@ void QS_obj_dict_pre_(
     void const * const obj,
     char const * const name)
 {
+    QS_TX_WAIT_(); // wait for room in the QS buffer (if needed)
+
     QS_CRIT_STAT
     QS_CRIT_ENTRY();
     QS_MEM_SYS();
@@ -769,6 +991,8 @@ void QS_obj_arr_dict_pre_(
 
     uint8_t j = ((*name == '&') ? 1U : 0U);
 
+    QS_TX_WAIT_(); // wait for room in the QS buffer (if needed)
+
     QS_CRIT_ENTRY();
     QS_MEM_SYS();
 
@@ -806,6 +1030,8 @@ void QS_fun_dict_pre_(
     QSpyFunPtr const fun,
     char const * const name)
 {
+    QS_TX_WAIT_(); // wait for room in the QS buffer (if needed)
+
     QS_CRIT_STAT
     QS_CRIT_ENTRY();
     QS_MEM_SYS();
@@ -825,6 +1051,8 @@ void QS_usr_dict_pre_(
     enum_t const rec,
     char const * const name)
 {
+    QS_TX_WAIT_(); // wait for room in the QS buffer (if needed)
+
     QS_CRIT_STAT
     QS_CRIT_ENTRY();
     QS_MEM_SYS();
@@ -845,6 +1073,8 @@ void QS_enum_dict_pre_(
     uint8_t const group,
     char const * const name)
 {
+    QS_TX_WAIT_(); // wait for room in the QS buffer (if needed)
+
     QS_CRIT_STAT
     QS_CRIT_ENTRY();
     QS_MEM_SYS();
@@ -990,6 +1220,197 @@ void QS_target_info_pre_(uint8_t const isReset) {
     QS_U8_PRE_((10U * (uint8_t)(DATE[9] - ZERO))
                + (uint8_t)(DATE[10] - ZERO));
     QS_endRec_();
+
+    QS_TARGET_INFO_EXT_(); // additional target info (if any)
+}
+
+#ifdef QS_OVERFLOW_POLICY
+//............................................................................
+void QS_dropRec_(uint8_t const rec) {
+    // NOTE: called in a critical section
+
+    ++l_ovf.nDropped[rec & 0x7FU];
+    l_ovf.changed = true;
+}
+
+//............................................................................
+void QS_overrun_(QSCtr const nBytes) {
+    // NOTE: called in a critical section
+
+    l_ovf.nOverrun += (uint32_t)nBytes;
+    l_ovf.changed = true;
+}
+
+//............................................................................
+void QS_overflow_pre_(void) {
+    QF_CRIT_STAT
+    QF_CRIT_ENTRY();
+    QF_MEM_SYS();
+
+    if (l_ovf.changed && !l_ovf.report) { // anything new to report?
+        l_ovf.changed = false;
+        l_ovf.report  = true;
+        l_ovf.next    = 0U;
+    }
+
+    // the report is split into QS_OVERFLOW records of at most QS_REC_MAX
+    // bytes, which are produced only into the free space of the QS buffer
+    // (the rest of the report is produced in the next calls)
+    while (l_ovf.report
+           && ((!QS_TX_SHARED_())
+               || ((QSCtr)(QS_priv_.used + QS_REC_MAX) <= QS_priv_.end)))
+    {
+        QS_beginRec_((uint_fast8_t)QS_OVERFLOW);
+            QS_TIME_PRE_();
+            QS_U8_PRE_(QS_OVERFLOW_POLICY);
+            QS_U32_PRE_(l_ovf.nOverrun);
+            // the (record-type, count) pairs of the dropped records
+            uint_fast8_t n = 0U;
+            uint_fast8_t rec = l_ovf.next;
+            for (; (rec < Q_DIM(l_ovf.nDropped)) && (n < QS_OVF_PAIRS_);
+                 ++rec)
+            {
+                if (l_ovf.nDropped[rec] != 0U) {
+                    QS_U8_PRE_(rec);
+                    QS_U32_PRE_(l_ovf.nDropped[rec]);
+                    ++n;
+                }
+            }
+            l_ovf.next = (uint8_t)rec;
+        QS_endRec_();
+
+        if (rec == Q_DIM(l_ovf.nDropped)) { // all record types reported?
+            l_ovf.report = false;
+        }
+    }
+
+    QF_MEM_APP();
+    QF_CRIT_EXIT();
+}
+#endif // def QS_OVERFLOW_POLICY
+
+#ifdef QS_SMP_MAX
+//............................................................................
+bool QS_smpFilter_(
+    uint_fast8_t const rec,
+    uint_fast16_t const nth,
+    uint_fast8_t const rate,
+    uint_fast8_t const burst)
+{
+    QF_CRIT_STAT
+    QF_CRIT_ENTRY();
+    QF_MEM_SYS();
+
+    uint_fast8_t const r = rec & 0x7FU;
+    uint8_t const bit = (uint8_t)(1U << (r & 7U));
+    bool const isOn = ((QS_filt_.smp[r >> 3U] & bit) != 0U);
+
+    // find the slot of the record (or a free slot)
+    uint_fast8_t i = 0U;
+    uint_fast8_t slot = QS_SMP_MAX;
+    for (; i < QS_SMP_MAX; ++i) {
+        if (QS_SMP_USED_(i)) {
+            if (isOn && (l_smp[i].rec == r)) {
+                slot = i;
+                break;
+            }
+        }
+        else if (!isOn && (slot == QS_SMP_MAX)) {
+            slot = i; // the first free slot
+        }
+        else {
+            // keep looking
+        }
+    }
+
+    bool const remove = (nth <= 1U) && (rate == 0U) && (burst == 0U);
+    if (slot < QS_SMP_MAX) {
+        if (remove) {
+            QS_filt_.smp[r >> 3U] &= (uint8_t)~bit;
+            l_smp[slot].nth   = 0U;
+            l_smp[slot].burst = 0U;
+        }
+        else {
+            uint8_t const max = (burst != 0U)
+                ? (uint8_t)burst
+                : (uint8_t)rate; // burst defaults to the rate
+            l_smp[slot].rec   = (uint8_t)r;
+            l_smp[slot].nth   = (uint16_t)nth;
+            l_smp[slot].cnt   = 0U;
+            l_smp[slot].rate  = (uint8_t)rate;
+            l_smp[slot].burst = max;
+            for (i = 0U; i < Q_DIM(l_smp[slot].tok); ++i) {
+                l_smp[slot].tok[i] = max;
+            }
+            QS_filt_.smp[r >> 3U] |= bit;
+        }
+    }
+
+    QF_MEM_APP();
+    QF_CRIT_EXIT();
+
+    return (slot < QS_SMP_MAX) || remove;
+}
+
+//............................................................................
+void QS_smpTick_(void) {
+    QF_CRIT_STAT
+    QF_CRIT_ENTRY();
+    QF_MEM_SYS();
+
+    for (uint_fast8_t i = 0U; i < QS_SMP_MAX; ++i) {
+        uint_fast8_t const rate = l_smp[i].rate;
+        if (rate != 0U) {
+            uint_fast8_t const burst = l_smp[i].burst;
+            for (uint_fast8_t id = 0U; id < Q_DIM(l_smp[i].tok); ++id) {
+                uint_fast8_t const tok = l_smp[i].tok[id];
+                l_smp[i].tok[id] = ((burst - tok) > rate)
+                    ? (uint8_t)(tok + rate)
+                    : (uint8_t)burst;
+            }
+        }
+    }
+
+    QF_MEM_APP();
+    QF_CRIT_EXIT();
+}
+
+//............................................................................
+bool QS_smpCheck_(
+    uint_fast8_t const rec,
+    uint_fast8_t const qs_id)
+{
+    // NOTE: called only for the records with the sampling or rate limit,
+    // typically in a critical section. Outside a critical section (in
+    // QS_BEGIN_ID()) the counters are updated without locking, so the
+    // sampling becomes only approximate.
+
+    bool pass = true;
+    for (uint_fast8_t i = 0U; i < QS_SMP_MAX; ++i) {
+        if ((l_smp[i].rec == rec) && QS_SMP_USED_(i)) {
+            if (l_smp[i].nth > 1U) { // sampling 1 in 'nth'?
+                ++l_smp[i].cnt;
+                if (l_smp[i].cnt < l_smp[i].nth) {
+                    pass = false;
+                }
+                else {
+                    l_smp[i].cnt = 0U;
+                }
+            }
+            if (pass && (l_smp[i].burst != 0U)) { // rate limit?
+                uint8_t * const tok = &l_smp[i].tok[qs_id & 0x7FU];
+                if (*tok != 0U) {
+                    --(*tok);
+                }
+                else {
+                    pass = false;
+                }
+            }
+            break;
+        }
+    }
+    return pass;
 }
+#endif // def QS_SMP_MAX
 
 //! @endcond
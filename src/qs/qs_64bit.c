@@ -49,21 +49,25 @@
 
 //! @static @private @memberof QS
 void QS_u64_raw_(uint64_t const d) {
-    uint8_t chksum      = QS_priv_.chksum;
-    uint8_t * const buf = QS_priv_.buf;
-    QSCtr head          = QS_priv_.head;
-    QSCtr const end     = QS_priv_.end;
+    uint8_t chksum      = QS_TX_.chksum;
+    uint8_t * const buf = QS_TX_.buf;
+    QSCtr head          = QS_TX_.head;
+    QSCtr const end     = QS_TX_.end;
 
-    QS_priv_.used += 8U; // 8 bytes are about to be added
+    QS_TX_.used += 8U; // 8 bytes are about to be added
+    #ifdef QS_FAST_FRAMING
+    QS_INSERT_BLOCK_(&d, 8U)
+    #else
     uint64_t u64 = d;
     for (uint_fast8_t i = 8U; i != 0U; --i) {
         uint8_t const b = (uint8_t)u64;
         QS_INSERT_ESC_BYTE_(b)
         u64 >>= 8U;
     }
+    #endif
 
-    QS_priv_.head   = head;   // save the head
-    QS_priv_.chksum = chksum; // save the checksum
+    QS_TX_.head   = head;   // save the head
+    QS_TX_.chksum = chksum; // save the checksum
 }
 
 //! @static @private @memberof QS
@@ -71,24 +75,28 @@ void QS_u64_fmt_(
     uint8_t const format,
     uint64_t const d)
 {
-    uint8_t chksum      = QS_priv_.chksum;
-    uint8_t * const buf = QS_priv_.buf;
-    QSCtr head          = QS_priv_.head;
-    QSCtr const end     = QS_priv_.end;
+    uint8_t chksum      = QS_TX_.chksum;
+    uint8_t * const buf = QS_TX_.buf;
+    QSCtr head          = QS_TX_.head;
+    QSCtr const end     = QS_TX_.end;
 
-    QS_priv_.used += 9U; // 9 bytes are about to be added
+    QS_TX_.used += 9U; // 9 bytes are about to be added
     QS_INSERT_ESC_BYTE_(format) // insert the format byte
 
     // output 8 bytes of data...
+    #ifdef QS_FAST_FRAMING
+    QS_INSERT_BLOCK_(&d, 8U)
+    #else
     uint64_t u64 = d;
     for (uint_fast8_t i = 8U; i != 0U; --i) {
         uint8_t const b = (uint8_t)u64;
         QS_INSERT_ESC_BYTE_(b)
         u64 >>= 8U;
     }
+    #endif
 
-    QS_priv_.head   = head;   // save the head
-    QS_priv_.chksum = chksum; // save the checksum
+    QS_TX_.head   = head;   // save the head
+    QS_TX_.chksum = chksum; // save the checksum
 }
 
 //! @endcond
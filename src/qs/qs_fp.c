@@ -56,25 +56,28 @@ void QS_f32_fmt_(
         float32_t f;
         uint32_t  u;
     } fu32;  // the internal binary representation
-    uint8_t chksum      = QS_priv_.chksum; // put in a temporary (register)
-    uint8_t * const buf = QS_priv_.buf;
-    QSCtr head          = QS_priv_.head;
-    QSCtr const end     = QS_priv_.end;
-    uint_fast8_t i;
+    uint8_t chksum      = QS_TX_.chksum;   // put in a temporary (register)
+    uint8_t * const buf = QS_TX_.buf;
+    QSCtr head          = QS_TX_.head;
+    QSCtr const end     = QS_TX_.end;
 
     fu32.f = f; // assign the binary representation
 
-    QS_priv_.used += 5U; // 5 bytes about to be added
+    QS_TX_.used += 5U; // 5 bytes about to be added
     QS_INSERT_ESC_BYTE_(format) // insert the format byte
 
     // insert 4 bytes...
-    for (i = 4U; i != 0U; --i) {
+    #ifdef QS_FAST_FRAMING
+    QS_INSERT_BLOCK_(&fu32.u, 4U)
+    #else
+    for (uint_fast8_t i = 4U; i != 0U; --i) {
         QS_INSERT_ESC_BYTE_((uint8_t)fu32.u)
         fu32.u >>= 8U;
     }
+    #endif
 
-    QS_priv_.head   = head;   // save the head
-    QS_priv_.chksum = chksum; // save the checksum
+    QS_TX_.head   = head;   // save the head
+    QS_TX_.chksum = chksum; // save the checksum
 }
 
 //! @static @private @memberof QS
@@ -86,10 +89,10 @@ void QS_f64_fmt_(
         float64_t d;
         uint32_t  u[2];
     } fu64; // the internal binary representation
-    uint8_t chksum      = QS_priv_.chksum;
-    uint8_t * const buf = QS_priv_.buf;
-    QSCtr head          = QS_priv_.head;
-    QSCtr const end     = QS_priv_.end;
+    uint8_t chksum      = QS_TX_.chksum;
+    uint8_t * const buf = QS_TX_.buf;
+    QSCtr head          = QS_TX_.head;
+    QSCtr const end     = QS_TX_.end;
     uint32_t i;
 
     // static constant untion to detect endianness of the machine
@@ -108,9 +111,13 @@ void QS_f64_fmt_(
         fu64.u[1] = i;
     }
 
-    QS_priv_.used += 9U; // 9 bytes about to be added
+    QS_TX_.used += 9U; // 9 bytes about to be added
     QS_INSERT_ESC_BYTE_(format) // insert the format byte
 
+    #ifdef QS_FAST_FRAMING
+    // output 8 bytes from fu64.u[0] and fu64.u[1]...
+    QS_INSERT_BLOCK_(&fu64.u[0], 8U)
+    #else
     // output 4 bytes from fu64.u[0]...
     for (i = 4U; i != 0U; --i) {
         QS_INSERT_ESC_BYTE_((uint8_t)fu64.u[0])
@@ -122,9 +129,10 @@ void QS_f64_fmt_(
         QS_INSERT_ESC_BYTE_((uint8_t)fu64.u[1])
         fu64.u[1] >>= 8U;
     }
+    #endif
 
-    QS_priv_.head   = head;   // save the head
-    QS_priv_.chksum = chksum; // save the checksum
+    QS_TX_.head   = head;   // save the head
+    QS_TX_.chksum = chksum; // save the checksum
 }
 
 //! @endcond
@@ -91,9 +91,15 @@ typedef struct {
 typedef struct {
     uint8_t data[16];
     uint8_t idx;
+    uint8_t len;
     int8_t  recId; // global/local
 } FltVar;
 
+#ifdef QS_SMP_MAX
+// length of the sampling filter: record, nth (2 bytes), rate, and burst
+#define QS_SMP_FLT_LEN 5U
+#endif
+
 typedef struct {
     QSObj    addr;
     uint8_t  idx;
@@ -579,8 +585,15 @@ static void QS_rxParseData_(uint8_t const b) {
             break;
         }
         case (uint8_t)WAIT4_FILTER_LEN: {
-            if (b == sizeof(l_rx.var.flt.data)) {
+            if ((b == sizeof(l_rx.var.flt.data))
+#ifdef QS_SMP_MAX
+                || ((b == QS_SMP_FLT_LEN)
+                    && (l_rx.var.flt.recId == (int8_t)QS_RX_GLB_FILTER))
+#endif
+                )
+            {
                 l_rx.var.flt.idx = 0U;
+                l_rx.var.flt.len = b;
                 QS_RX_TRAN_(WAIT4_FILTER_DATA);
             }
             else {
@@ -592,7 +605,7 @@ static void QS_rxParseData_(uint8_t const b) {
         case (uint8_t)WAIT4_FILTER_DATA: {
             l_rx.var.flt.data[l_rx.var.flt.idx] = b;
             ++l_rx.var.flt.idx;
-            if (l_rx.var.flt.idx == sizeof(l_rx.var.flt.data)) {
+            if (l_rx.var.flt.idx == l_rx.var.flt.len) {
                 QS_RX_TRAN_(WAIT4_FILTER_FRAME);
             }
             break;
@@ -865,6 +878,22 @@ static void QS_rxHandleGoodFrame_(uint8_t const state) {
             break;
         }
         case WAIT4_FILTER_FRAME: {
+#ifdef QS_SMP_MAX
+            // sampling filter of one record?
+            if (l_rx.var.flt.len == QS_SMP_FLT_LEN) {
+                uint8_t const * const d = &l_rx.var.flt.data[0];
+                if (QS_smpFilter_(d[0],
+                        (uint_fast16_t)d[1] | ((uint_fast16_t)d[2] << 8U),
+                        d[3], d[4]))
+                {
+                    QS_rxReportAck_(l_rx.var.flt.recId);
+                }
+                else { // no free sampling slot
+                    QS_rxReportError_(l_rx.var.flt.recId);
+                }
+                break;
+            }
+#endif
             QS_rxReportAck_(l_rx.var.flt.recId);
 
             // apply the received filters
@@ -249,6 +249,7 @@ void QXK_activate_(void) {
 
         // dispatch event (virtual call)
         (*next->super.vptr->dispatch)(&next->super, e, p);
+        QACTIVE_RTC_END_(next);
     #if (QF_MAX_EPOOL > 0U)
         QF_gc(e);
     #endif
@@ -0,0 +1,275 @@
+#include "et.h"       // Embedded Test (ET)
+
+// includes for the CUT...
+#include "qp_port.h"      // QP port
+#include "qsafe.h"        // QP Functional Safety (FuSa) System
+#ifdef Q_SPY // software tracing enabled?
+#include "qs_port.h"      // QS/C port from the port directory
+#else
+#include "qs_dummy.h"     // QS/C dummy (inactive) interface
+#endif
+
+Q_DEFINE_THIS_MODULE("test")
+
+enum TestSignals {
+    A_SIG = Q_USER_SIG,
+    B_SIG,
+    C_SIG,
+    D_SIG
+};
+
+// state hierarchy: top > s > (s1 > s11 > s111), s2
+static QState Hsm_initial(QHsm * const me, void const * const par);
+static QState Hsm_s    (QHsm * const me, QEvt const * const e);
+static QState Hsm_s1   (QHsm * const me, QEvt const * const e);
+static QState Hsm_s11  (QHsm * const me, QEvt const * const e);
+static QState Hsm_s111 (QHsm * const me, QEvt const * const e);
+static QState Hsm_s2   (QHsm * const me, QEvt const * const e);
+
+#ifdef Q_SPY
+static uint8_t qsBuf[1024];  // buffer for QS-TX channel
+#endif
+
+static QHsm hsm;
+static uint_fast16_t nCalls; // # calls to the state handlers
+
+static QEvt const evtA = QEVT_INITIALIZER(A_SIG);
+static QEvt const evtB = QEVT_INITIALIZER(B_SIG);
+static QEvt const evtC = QEVT_INITIALIZER(C_SIG);
+#ifdef QHSM_ANCESTOR_CACHE
+static QEvt const evtD = QEVT_INITIALIZER(D_SIG);
+#endif
+
+#define IS_IN(state_) QASM_IS_IN(&hsm.super, Q_STATE_CAST(&(state_)))
+#define CHILD(parent_) QHsm_childState(&hsm, Q_STATE_CAST(&(parent_)))
+
+void setup(void) {
+}
+
+void teardown(void) {
+}
+
+// test group --------------------------------------------------------------
+TEST_GROUP("QHsm superstate chain") {
+
+#ifdef Q_SPY
+QS_initBuf(qsBuf, sizeof(qsBuf));
+#endif
+QHsm_ctor(&hsm, Q_STATE_CAST(&Hsm_initial));
+QASM_INIT(&hsm.super, (void *)0, 0U);
+
+TEST("isIn() after the initial transition") {
+    uint_fast16_t const n = nCalls;
+    VERIFY(IS_IN(Hsm_s11));
+    VERIFY(IS_IN(Hsm_s1));
+    VERIFY(IS_IN(Hsm_s));
+    VERIFY(IS_IN(QHsm_top));
+    VERIFY(!IS_IN(Hsm_s2));
+    VERIFY(!IS_IN(Hsm_s111));
+#ifdef QHSM_ANCESTOR_CACHE
+    VERIFY(n == nCalls); // no state handlers called
+#else
+    (void)n;
+#endif
+}
+
+TEST("childState() after the initial transition") {
+    uint_fast16_t const n = nCalls;
+    VERIFY(Q_STATE_CAST(&Hsm_s1)  == CHILD(Hsm_s));
+    VERIFY(Q_STATE_CAST(&Hsm_s11) == CHILD(Hsm_s1));
+    VERIFY(Q_STATE_CAST(&Hsm_s)   == CHILD(QHsm_top));
+#ifdef QHSM_ANCESTOR_CACHE
+    VERIFY(n == nCalls); // no state handlers called
+#else
+    (void)n;
+#endif
+}
+
+TEST("transition updates the superstate chain") {
+    QASM_DISPATCH(&hsm.super, &evtA, 0U); // s11 -> s2
+    VERIFY(IS_IN(Hsm_s2));
+    VERIFY(IS_IN(Hsm_s));
+    VERIFY(!IS_IN(Hsm_s1));
+    VERIFY(!IS_IN(Hsm_s11));
+    VERIFY(Q_STATE_CAST(&Hsm_s2) == CHILD(Hsm_s));
+
+    QASM_DISPATCH(&hsm.super, &evtC, 0U); // internal transition in s2
+    VERIFY(IS_IN(Hsm_s2));
+    VERIFY(!IS_IN(Hsm_s1));
+
+    QASM_DISPATCH(&hsm.super, &evtB, 0U); // s2 -> s1 -> s11
+    VERIFY(IS_IN(Hsm_s11));
+    VERIFY(IS_IN(Hsm_s1));
+    VERIFY(!IS_IN(Hsm_s2));
+    VERIFY(Q_STATE_CAST(&Hsm_s11) == CHILD(Hsm_s1));
+}
+
+#ifdef QHSM_ANCESTOR_CACHE
+TEST("state nested deeper than the cache (expected assertion)") {
+    ET_expect_assert("qep_hsm", 710);
+    QASM_DISPATCH(&hsm.super, &evtD, 0U); // s11 -> s111
+}
+#endif
+
+} // TEST_GROUP()
+
+//==========================================================================
+static QState Hsm_initial(QHsm * const me, void const * const par) {
+    (void)par;
+    ++nCalls;
+    return Q_TRAN(&Hsm_s11);
+}
+//..........................................................................
+static QState Hsm_s(QHsm * const me, QEvt const * const e) {
+    QState status_;
+    ++nCalls;
+    switch (e->sig) {
+        case D_SIG: {
+            status_ = Q_TRAN(&Hsm_s111);
+            break;
+        }
+        default: {
+            status_ = Q_SUPER(&QHsm_top);
+            break;
+        }
+    }
+    return status_;
+}
+//..........................................................................
+static QState Hsm_s1(QHsm * const me, QEvt const * const e) {
+    QState status_;
+    ++nCalls;
+    switch (e->sig) {
+        case Q_INIT_SIG: {
+            status_ = Q_TRAN(&Hsm_s11);
+            break;
+        }
+        case A_SIG: {
+            status_ = Q_TRAN(&Hsm_s2);
+            break;
+        }
+        default: {
+            status_ = Q_SUPER(&Hsm_s);
+            break;
+        }
+    }
+    return status_;
+}
+//..........................................................................
+static QState Hsm_s11(QHsm * const me, QEvt const * const e) {
+    ++nCalls;
+    (void)e;
+    return Q_SUPER(&Hsm_s1);
+}
+//..........................................................................
+static QState Hsm_s111(QHsm * const me, QEvt const * const e) {
+    ++nCalls;
+    (void)e;
+    return Q_SUPER(&Hsm_s11);
+}
+//..........................................................................
+static QState Hsm_s2(QHsm * const me, QEvt const * const e) {
+    QState status_;
+    ++nCalls;
+    switch (e->sig) {
+        case B_SIG: {
+            status_ = Q_TRAN(&Hsm_s1);
+            break;
+        }
+        case C_SIG: {
+            status_ = Q_HANDLED();
+            break;
+        }
+        default: {
+            status_ = Q_SUPER(&Hsm_s);
+            break;
+        }
+    }
+    return status_;
+}
+
+// =========================================================================
+// dependencies for the CUT ...
+
+//..........................................................................
+void QF_poolInit(void * const poolSto, uint_fast32_t const poolSize,
+    uint_fast16_t const evtSize)
+{
+    (void)poolSto;
+    (void)poolSize;
+    (void)evtSize;
+}
+//..........................................................................
+uint_fast16_t QF_poolGetMaxBlockSize(void) {
+    return 0U;
+}
+//..........................................................................
+void QActive_publish_(QEvt const * const e,
+                      void const * const sender, uint_fast8_t const qs_id)
+{
+    (void)e;
+    (void)sender;
+    (void)qs_id;
+}
+//..........................................................................
+void QTimeEvt_tick_(uint_fast8_t const tickRate, void const * const sender) {
+    (void)tickRate;
+    (void)sender;
+}
+//..........................................................................
+void QTimeEvt_tickN_(uint_fast8_t const tickRate,
+    QTimeEvtCtr const nTicks, void const * const sender)
+{
+    (void)tickRate;
+    (void)nTicks;
+    (void)sender;
+}
+//..........................................................................
+QEvt *QF_newX_(uint_fast16_t const evtSize,
+    uint_fast16_t const margin, enum_t const sig)
+{
+    (void)evtSize;
+    (void)margin;
+    (void)sig;
+
+    return (QEvt *)0;
+}
+//..........................................................................
+//! @static @public @memberof QF
+void QF_gc(QEvt const * const e) {
+    (void)e;
+}
+
+//..........................................................................
+Q_NORETURN Q_onError(char const * const module, int_t const location) {
+    VERIFY_ASSERT(module, location);
+    for (;;) { // explicitly make it "noreturn"
+    }
+}
+
+//--------------------------------------------------------------------------
+#ifdef Q_SPY
+
+void QS_onCleanup(void) {
+}
+//..........................................................................
+void QS_onReset(void) {
+}
+//..........................................................................
+void QS_onFlush(void) {
+}
+//..........................................................................
+QSTimeCtr QS_onGetTime(void) {
+    return (QSTimeCtr)0U;
+}
+//..........................................................................
+void QS_onCommand(uint8_t cmdId, uint32_t param1,
+    uint32_t param2, uint32_t param3)
+{
+    (void)cmdId;
+    (void)param1;
+    (void)param2;
+    (void)param3;
+}
+
+#endif // Q_SPY
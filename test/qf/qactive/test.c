@@ -0,0 +1,333 @@
+#include "et.h"       // Embedded Test (ET)
+
+// includes for the CUT...
+#include "qp_port.h"      // QP port
+#include "qsafe.h"        // QP Functional Safety (FuSa) System
+#ifdef Q_SPY // software tracing enabled?
+#include "qs_port.h"      // QS/C port from the port directory
+#else
+#include "qs_dummy.h"     // QS/C dummy (inactive) interface
+#endif
+
+enum { QUEUE_SIZE = 5 };
+
+enum TestSignals {
+    A_SIG = Q_USER_SIG,
+    B_SIG,
+    C_SIG
+};
+
+static QState AO_initial(QActive * const me, void const * const par);
+static QState AO_active (QActive * const me, QEvt const * const e);
+
+static QActive ao;
+static QEvt const *aoQueSto[QUEUE_SIZE];
+
+static QEvt const evtA = QEVT_INITIALIZER(A_SIG);
+static QEvt const evtB = QEVT_INITIALIZER(B_SIG);
+static QEvt const evtC = QEVT_INITIALIZER(C_SIG);
+static QEvt const evtA2 = QEVT_INITIALIZER(A_SIG);
+static QEvt const evtB2 = QEVT_INITIALIZER(B_SIG);
+static QEvt evtMut = { (QSignal)A_SIG, 0U, QEVT_MARKER | 1U }; // "mutable"
+
+// deferred queue with the recall priorities of the signals
+static QDeferQueue dq;
+static QEvt const *dqSto[4];
+static uint8_t const sigPrio[] = {
+    [A_SIG] = 1U,
+    [B_SIG] = 3U,
+    [C_SIG] = 2U
+};
+
+static QEvt const *gcEvt; // the last event passed to QF_gc()
+
+uint32_t QF_latTime; // time source of the latency histograms (QF_LAT_TIME)
+
+// # events in the queue of the AO (including the front event)
+static uint_fast16_t nQueued(void) {
+    return (uint_fast16_t)((ao.eQueue.end + 1U) - ao.eQueue.nFree);
+}
+
+// remove all events from the queue of the AO
+static void flush(void) {
+    while (ao.eQueue.frontEvt != (QEvt *)0) {
+        (void)QActive_get_(&ao);
+    }
+}
+
+void setup(void) {
+}
+
+void teardown(void) {
+    flush();
+}
+
+// test group --------------------------------------------------------------
+TEST_GROUP("QActive") {
+
+QActive_ctor(&ao, Q_STATE_CAST(&AO_initial));
+ao.prio = 1U;
+QActive_register_(&ao);
+QEQueue_init(&ao.eQueue, aoQueSto, Q_DIM(aoQueSto));
+QDeferQueue_init(&dq, dqSto, Q_DIM(dqSto), sigPrio, Q_DIM(sigPrio));
+
+TEST("signal filter rejects the ignored signals") {
+    QActive_ignoreSig(&ao, A_SIG);
+    VERIFY(0U == QActive_getNFiltered(&ao));
+
+    VERIFY(QACTIVE_POST_X(&ao, &evtA, QF_NO_MARGIN, (void *)0));
+    VERIFY(QACTIVE_POST_X(&ao, &evtB, QF_NO_MARGIN, (void *)0));
+    VERIFY(1U == nQueued());
+    VERIFY(&evtB == QActive_get_(&ao));
+    VERIFY(1U == QActive_getNFiltered(&ao));
+}
+
+TEST("signal filter recycles the rejected mutable events") {
+    gcEvt = (QEvt *)0;
+    VERIFY(QACTIVE_POST_X(&ao, &evtMut, QF_NO_MARGIN, (void *)0));
+    VERIFY(0U == nQueued());
+    VERIFY(&evtMut == gcEvt);
+    VERIFY(1U == evtMut.refCtr_); // QF_gc() stub does not decrement
+    evtMut.refCtr_ = 0U;
+    VERIFY(2U == QActive_getNFiltered(&ao));
+}
+
+TEST("accepted signal is queued again") {
+    QActive_acceptSig(&ao, A_SIG);
+    VERIFY(QACTIVE_POST_X(&ao, &evtA, QF_NO_MARGIN, (void *)0));
+    VERIFY(1U == nQueued());
+    VERIFY(&evtA == QActive_get_(&ao));
+    VERIFY(2U == QActive_getNFiltered(&ao));
+}
+
+TEST("coalescing post to an empty queue posts the event") {
+    VERIFY(QACTIVE_POST_COALESCE(&ao, &evtA, QF_NO_MARGIN, (void *)0));
+    VERIFY(1U == nQueued());
+    VERIFY(&evtA == QActive_get_(&ao));
+}
+
+TEST("coalescing post replaces the pending front event") {
+    VERIFY(QACTIVE_POST_X(&ao, &evtA, QF_NO_MARGIN, (void *)0));
+    VERIFY(QACTIVE_POST_X(&ao, &evtB, QF_NO_MARGIN, (void *)0));
+    VERIFY(QACTIVE_POST_COALESCE(&ao, &evtA2, QF_NO_MARGIN, (void *)0));
+    VERIFY(2U == nQueued());
+    VERIFY(&evtA2 == QActive_get_(&ao));
+    VERIFY(&evtB  == QActive_get_(&ao));
+}
+
+TEST("coalescing post replaces the oldest pending event in place") {
+    VERIFY(QACTIVE_POST_X(&ao, &evtC, QF_NO_MARGIN, (void *)0));
+    VERIFY(QACTIVE_POST_X(&ao, &evtB, QF_NO_MARGIN, (void *)0));
+    VERIFY(QACTIVE_POST_X(&ao, &evtA, QF_NO_MARGIN, (void *)0));
+    VERIFY(QACTIVE_POST_X(&ao, &evtB, QF_NO_MARGIN, (void *)0));
+    VERIFY(QACTIVE_POST_COALESCE(&ao, &evtB2, QF_NO_MARGIN, (void *)0));
+    VERIFY(4U == nQueued());
+    VERIFY(&evtC  == QActive_get_(&ao));
+    VERIFY(&evtB2 == QActive_get_(&ao));
+    VERIFY(&evtA  == QActive_get_(&ao));
+    VERIFY(&evtB  == QActive_get_(&ao));
+}
+
+TEST("coalescing post recycles the replaced event") {
+    VERIFY(QACTIVE_POST_X(&ao, &evtB, QF_NO_MARGIN, (void *)0));
+    VERIFY(QACTIVE_POST_X(&ao, &evtMut, QF_NO_MARGIN, (void *)0));
+    VERIFY(1U == evtMut.refCtr_);
+    gcEvt = (QEvt *)0;
+    VERIFY(QACTIVE_POST_COALESCE(&ao, &evtA, QF_NO_MARGIN, (void *)0));
+    VERIFY(&evtMut == gcEvt);
+    evtMut.refCtr_ = 0U; // QF_gc() stub does not decrement
+    VERIFY(&evtB == QActive_get_(&ao));
+    VERIFY(&evtA == QActive_get_(&ao));
+}
+
+TEST("coalescing post into a full queue") {
+    VERIFY(QACTIVE_POST_X(&ao, &evtA, QF_NO_MARGIN, (void *)0));
+    for (uint_fast8_t n = 1U; n < QUEUE_SIZE + 1U; ++n) {
+        VERIFY(QACTIVE_POST_X(&ao, &evtC, QF_NO_MARGIN, (void *)0));
+    }
+    VERIFY(0U == ao.eQueue.nFree);
+    VERIFY(QACTIVE_POST_COALESCE(&ao, &evtA2, QF_NO_MARGIN, (void *)0));
+    VERIFY(false == QACTIVE_POST_COALESCE(&ao, &evtB, 0U, (void *)0));
+    VERIFY(QUEUE_SIZE + 1U == nQueued());
+    VERIFY(&evtA2 == QActive_get_(&ao));
+}
+
+TEST("coalesced event is time stamped and recorded as posted") {
+    QF_latTime = 10U;
+    VERIFY(QACTIVE_POST_X(&ao, &evtA, QF_NO_MARGIN, (void *)0));
+    QF_latTime = 20U;
+    VERIFY(QACTIVE_POST_X(&ao, &evtB, QF_NO_MARGIN, &ao));
+    QF_latTime = 100U;
+    VERIFY(QACTIVE_POST_COALESCE(&ao, &evtA2, QF_NO_MARGIN, &ao));
+
+    QHistEntry h;
+    VERIFY(1U == QActive_getHist(&ao, &h, 1U));
+    VERIFY((uint8_t)QF_HIST_POST == h.kind);
+    VERIFY((QSignal)A_SIG == h.sig);
+    VERIFY((uintptr_t)&ao == h.addr);
+    VERIFY(100U == h.stamp);
+
+    QF_latTime = 130U;
+    VERIFY(&evtA2 == QActive_get_(&ao));
+    VERIFY(30U == QActive_getLat(&ao, QF_LAT_QUEUE)->max);
+    QF_latTime = 140U;
+    VERIFY(&evtB == QActive_get_(&ao));
+    VERIFY(120U == QActive_getLat(&ao, QF_LAT_QUEUE)->max);
+    QF_latTime = 0U;
+}
+
+TEST("priority deferral orders the events by the signal priority") {
+    VERIFY(QActive_deferPrio(&ao, &dq, &evtA));
+    VERIFY(QActive_deferPrio(&ao, &dq, &evtC));
+    VERIFY(QActive_deferPrio(&ao, &dq, &evtB));
+    VERIFY(QActive_deferPrio(&ao, &dq, &evtA2));
+    VERIFY(4U == QActive_recallN(&ao, &dq.super, 10U));
+    VERIFY(QEQueue_isEmpty(&dq.super));
+    VERIFY(&evtB  == QActive_get_(&ao));
+    VERIFY(&evtC  == QActive_get_(&ao));
+    VERIFY(&evtA  == QActive_get_(&ao));
+    VERIFY(&evtA2 == QActive_get_(&ao));
+}
+
+TEST("bulk recall splices the events in front of the queued events") {
+    VERIFY(QACTIVE_POST_X(&ao, &evtA, QF_NO_MARGIN, (void *)0));
+    VERIFY(QActive_deferPrio(&ao, &dq, &evtA2));
+    VERIFY(QActive_deferPrio(&ao, &dq, &evtC));
+    VERIFY(QActive_deferPrio(&ao, &dq, &evtB));
+    VERIFY(2U == QActive_recallN(&ao, &dq.super, 2U));
+    VERIFY(3U == nQueued());
+    VERIFY(&evtB == QActive_get_(&ao));
+    VERIFY(&evtC == QActive_get_(&ao));
+    VERIFY(&evtA == QActive_get_(&ao));
+
+    VERIFY(1U == QActive_recallN(&ao, &dq.super, 2U));
+    VERIFY(&evtA2 == QActive_get_(&ao));
+    VERIFY(0U == QActive_recallN(&ao, &dq.super, 2U));
+}
+
+TEST("bulk recall is limited by the free entries in the AO queue") {
+    for (uint_fast8_t n = 0U; n < QUEUE_SIZE; ++n) {
+        VERIFY(QACTIVE_POST_X(&ao, &evtC, QF_NO_MARGIN, (void *)0));
+    }
+    VERIFY(QActive_deferPrio(&ao, &dq, &evtA));
+    VERIFY(QActive_deferPrio(&ao, &dq, &evtB));
+    VERIFY(1U == QActive_recallN(&ao, &dq.super, 10U));
+    VERIFY(0U == ao.eQueue.nFree);
+    VERIFY(0U == QActive_recallN(&ao, &dq.super, 10U));
+    VERIFY(&evtB == QActive_get_(&ao));
+    flush();
+    VERIFY(1U == QActive_recallN(&ao, &dq.super, 10U));
+    VERIFY(&evtA == QActive_get_(&ao));
+}
+
+TEST("deferral into a full deferred queue fails") {
+    for (uint_fast8_t n = 0U; n < Q_DIM(dqSto) + 1U; ++n) {
+        VERIFY(QActive_deferPrio(&ao, &dq, &evtA));
+    }
+    VERIFY(false == QActive_deferPrio(&ao, &dq, &evtB));
+    VERIFY(Q_DIM(dqSto) + 1U == QActive_flushDeferred(&ao, &dq.super, 10U));
+}
+
+TEST("reserved signal cannot be ignored (expected assertion)") {
+    ET_expect_assert("qf_actq", 600);
+    QActive_ignoreSig(&ao, Q_ENTRY_SIG);
+}
+
+} // TEST_GROUP()
+
+//==========================================================================
+static QState AO_initial(QActive * const me, void const * const par) {
+    (void)par;
+    return Q_TRAN(&AO_active);
+}
+//..........................................................................
+static QState AO_active(QActive * const me, QEvt const * const e) {
+    (void)e;
+    return Q_SUPER(&QHsm_top);
+}
+
+// =========================================================================
+// dependencies for the CUT ...
+
+//..........................................................................
+void QF_poolInit(void * const poolSto, uint_fast32_t const poolSize,
+    uint_fast16_t const evtSize)
+{
+    (void)poolSto;
+    (void)poolSize;
+    (void)evtSize;
+}
+//..........................................................................
+uint_fast16_t QF_poolGetMaxBlockSize(void) {
+    return 0U;
+}
+//..........................................................................
+void QActive_publish_(QEvt const * const e,
+                      void const * const sender, uint_fast8_t const qs_id)
+{
+    (void)e;
+    (void)sender;
+    (void)qs_id;
+}
+//..........................................................................
+void QTimeEvt_tick_(uint_fast8_t const tickRate, void const * const sender) {
+    (void)tickRate;
+    (void)sender;
+}
+//..........................................................................
+void QTimeEvt_tickN_(uint_fast8_t const tickRate,
+    QTimeEvtCtr const nTicks, void const * const sender)
+{
+    (void)tickRate;
+    (void)nTicks;
+    (void)sender;
+}
+//..........................................................................
+QEvt *QF_newX_(uint_fast16_t const evtSize,
+    uint_fast16_t const margin, enum_t const sig)
+{
+    (void)evtSize;
+    (void)margin;
+    (void)sig;
+
+    return (QEvt *)0;
+}
+//..........................................................................
+//! @static @public @memberof QF
+void QF_gc(QEvt const * const e) {
+    gcEvt = e;
+}
+
+//..........................................................................
+Q_NORETURN Q_onError(char const * const module, int_t const location) {
+    VERIFY_ASSERT(module, location);
+    for (;;) { // explicitly make it "noreturn"
+    }
+}
+
+//--------------------------------------------------------------------------
+#ifdef Q_SPY
+
+void QS_onCleanup(void) {
+}
+//..........................................................................
+void QS_onReset(void) {
+}
+//..........................................................................
+void QS_onFlush(void) {
+}
+//..........................................................................
+QSTimeCtr QS_onGetTime(void) {
+    return (QSTimeCtr)0U;
+}
+//..........................................................................
+void QS_onCommand(uint8_t cmdId, uint32_t param1,
+    uint32_t param2, uint32_t param3)
+{
+    (void)cmdId;
+    (void)param1;
+    (void)param2;
+    (void)param3;
+}
+
+#endif // Q_SPY
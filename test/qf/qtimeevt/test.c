@@ -0,0 +1,392 @@
+#include "et.h"       // Embedded Test (ET)
+
+// includes for the CUT...
+#include "qp_port.h"      // QP port
+#include "qsafe.h"        // QP Functional Safety (FuSa) System
+#ifdef Q_SPY // software tracing enabled?
+#include "qs_port.h"      // QS/C port from the port directory
+#else
+#include "qs_dummy.h"     // QS/C dummy (inactive) interface
+#endif
+
+enum { QUEUE_SIZE = 4 };
+
+enum TestSignals {
+    TIMEOUT_SIG = Q_USER_SIG,
+    TIMEOUT2_SIG
+};
+
+static QState AO_initial(QActive * const me, void const * const par);
+static QState AO_active (QActive * const me, QEvt const * const e);
+
+static QActive ao;
+static QEvt const *aoQueSto[QUEUE_SIZE];
+#ifdef QTIMEEVT_SHARDS
+static QActive ao2; // AO in another shard than 'ao'
+static QEvt const *ao2QueSto[QUEUE_SIZE];
+#endif
+static QTimeEvt te;
+static QEvt const evtFill = QEVT_INITIALIZER(TIMEOUT2_SIG);
+#ifdef QTIMEEVT_SLACK
+static QTimeEvt teSlack1;
+static QTimeEvt teSlack2;
+#endif
+
+// # events in the queue of the AO (including the front event)
+static uint_fast16_t nQueued(void) {
+    return (uint_fast16_t)((ao.eQueue.end + 1U) - ao.eQueue.nFree);
+}
+
+// remove all events from the queue of the AO
+static void flush(void) {
+    while (ao.eQueue.frontEvt != (QEvt *)0) {
+        (void)QActive_get_(&ao);
+    }
+}
+
+// process 'n_' clock ticks of the tick rate 'rate_' in one call
+#define TICK_N(rate_, n_) QTimeEvt_tickN_((rate_), (n_), (void *)0)
+
+// fill the queue of the AO completely
+static void fill(void) {
+    while (ao.eQueue.nFree > 0U) {
+        (void)QACTIVE_POST_X(&ao, &evtFill, QF_NO_MARGIN, (void *)0);
+    }
+}
+
+#ifdef QTIMEEVT_SHARDS
+uint8_t QF_shardLocked[QTIMEEVT_SHARDS];
+uint32_t QF_shardLockCtr[QTIMEEVT_SHARDS];
+
+// all shard locks released?
+static bool shardsUnlocked(void) {
+    bool unlocked = true;
+    for (uint_fast8_t shard = 0U; shard < QTIMEEVT_SHARDS; ++shard) {
+        if (QF_shardLocked[shard] != 0U) {
+            unlocked = false;
+        }
+    }
+    return unlocked;
+}
+#endif
+
+#ifdef QTIMEEVT_SLACK
+// tick until the tick count reaches a boundary of the given slack
+static void syncSlack(QTimeEvtCtr const slack) {
+    QTimeEvt_armSlack(&teSlack1, 1U, 0U, slack);
+    while (0U == nQueued()) {
+        TICK_N(0U, 1U);
+    }
+    flush();
+}
+#endif
+
+void setup(void) {
+}
+
+void teardown(void) {
+    (void)QTimeEvt_disarm(&te);
+#ifdef QTIMEEVT_SLACK
+    (void)QTimeEvt_disarm(&teSlack1);
+    (void)QTimeEvt_disarm(&teSlack2);
+#endif
+    TICK_N(0U, 1U); // unlink the disarmed time event
+    flush();
+#ifdef QTIMEEVT_POST_POLICY
+    QTimeEvt_setPolicy(&te, QTIMEEVT_POLICY_ASSERT);
+#endif
+}
+
+// test group --------------------------------------------------------------
+TEST_GROUP("QTimeEvt") {
+
+QActive_ctor(&ao, Q_STATE_CAST(&AO_initial));
+ao.prio = 1U;
+QActive_register_(&ao);
+QEQueue_init(&ao.eQueue, aoQueSto, Q_DIM(aoQueSto));
+#ifdef QTIMEEVT_SHARDS
+QActive_ctor(&ao2, Q_STATE_CAST(&AO_initial));
+ao2.prio = 2U;
+QActive_register_(&ao2);
+QEQueue_init(&ao2.eQueue, ao2QueSto, Q_DIM(ao2QueSto));
+#endif
+QTimeEvt_ctorX(&te, &ao, TIMEOUT_SIG, 0U);
+#ifdef QTIMEEVT_SLACK
+QTimeEvt_ctorX(&teSlack1, &ao, TIMEOUT_SIG, 0U);
+QTimeEvt_ctorX(&teSlack2, &ao, TIMEOUT2_SIG, 0U);
+#endif
+
+TEST("time event not expiring within the catch-up is decremented") {
+    QTimeEvt_armX(&te, 10U, 0U);
+    TICK_N(0U, 7U);
+    VERIFY(0U == nQueued());
+    VERIFY(3U == QTimeEvt_currCtr(&te));
+    TICK_N(0U, 3U);
+    VERIFY(1U == nQueued());
+}
+
+TEST("one-shot time event expires once within the catch-up") {
+    QTimeEvt_armX(&te, 4U, 0U);
+    TICK_N(0U, 10U);
+    VERIFY(1U == nQueued());
+    VERIFY(&te.super == QActive_get_(&ao));
+    VERIFY(0U == QTimeEvt_currCtr(&te)); // disarmed
+    TICK_N(0U, 10U);
+    VERIFY(0U == nQueued());
+}
+
+TEST("periodic time event is re-armed in phase after the catch-up") {
+    QTimeEvt_armX(&te, 3U, 5U); // expiries at 3, 8, 13, 18, ...
+    TICK_N(0U, 12U);
+    VERIFY(1U == nQueued()); // the expiries at 3 and 8 are coalesced
+    VERIFY(1U == QTimeEvt_currCtr(&te));
+    flush();
+    TICK_N(0U, 1U);          // tick 13
+    VERIFY(1U == nQueued());
+    VERIFY(5U == QTimeEvt_currCtr(&te));
+    flush();
+    TICK_N(0U, 5U);          // exactly one interval (tick 18)
+    VERIFY(1U == nQueued());
+    VERIFY(5U == QTimeEvt_currCtr(&te));
+}
+
+TEST("catch-up by N ticks matches N single ticks") {
+    static QTimeEvt te2;
+    QTimeEvt_ctorX(&te2, &ao, TIMEOUT2_SIG, 1U);
+    QTimeEvt_armX(&te,  2U, 7U);
+    QTimeEvt_armX(&te2, 2U, 7U);
+    for (uint_fast8_t n = 0U; n < 20U; ++n) {
+        QTimeEvt_tick_(1U, (void *)0);
+    }
+    TICK_N(0U, 20U);
+    VERIFY(QTimeEvt_currCtr(&te2) == QTimeEvt_currCtr(&te));
+    VERIFY(QTimeEvt_disarm(&te2));
+    TICK_N(1U, 1U); // unlink the disarmed time event
+}
+
+#ifdef QTIMEEVT_SLACK
+TEST("slack batches the expiries of time events armed at different ticks") {
+    syncSlack(3U); // the batches are 4 ticks apart
+    QTimeEvt_armSlack(&teSlack1, 5U, 0U, 3U);
+    VERIFY(8U == QTimeEvt_currCtr(&teSlack1));
+    TICK_N(0U, 1U);
+    QTimeEvt_armSlack(&teSlack2, 6U, 0U, 3U);
+    VERIFY(7U == QTimeEvt_currCtr(&teSlack2));
+    TICK_N(0U, 6U);
+    VERIFY(0U == nQueued());
+    TICK_N(0U, 1U);
+    VERIFY(2U == nQueued()); // both expire at the same tick
+}
+
+TEST("slack delays a periodic time event by at most the slack") {
+    syncSlack(1U); // the batches are 2 ticks apart
+    QTimeEvt_armSlack(&teSlack1, 4U, 5U, 1U);
+    VERIFY(4U == QTimeEvt_currCtr(&teSlack1)); // already aligned
+    for (uint_fast8_t n = 0U; n < 3U; ++n) {
+        TICK_N(0U, QTimeEvt_currCtr(&teSlack1));
+        VERIFY(1U == nQueued());
+        flush();
+        VERIFY(6U == QTimeEvt_currCtr(&teSlack1)); // interval + 1
+    }
+}
+
+TEST("zero slack does not delay the expiry") {
+    QTimeEvt_armSlack(&teSlack1, 5U, 3U, 0U);
+    VERIFY(5U == QTimeEvt_currCtr(&teSlack1));
+    TICK_N(0U, 5U);
+    VERIFY(1U == nQueued());
+    VERIFY(3U == QTimeEvt_currCtr(&teSlack1));
+}
+#endif // def QTIMEEVT_SLACK
+
+#ifdef QTIMEEVT_POST_POLICY
+TEST("drop policy drops the expiry of a periodic time event") {
+    uint32_t const nDropped = QTimeEvt_getNDropped(0U);
+    QTimeEvt_setPolicy(&te, QTIMEEVT_POLICY_DROP);
+    QTimeEvt_armX(&te, 1U, 1U);
+    fill();
+    TICK_N(0U, 1U);
+    VERIFY(nDropped + 1U == QTimeEvt_getNDropped(0U));
+    VERIFY(1U == QTimeEvt_currCtr(&te)); // still armed
+    flush();
+    TICK_N(0U, 1U);
+    VERIFY(1U == nQueued());
+    VERIFY(&te.super == QActive_get_(&ao));
+}
+
+TEST("drop policy drops the expiry of a one-shot time event") {
+    uint32_t const nDropped = QTimeEvt_getNDropped(0U);
+    QTimeEvt_setPolicy(&te, QTIMEEVT_POLICY_DROP);
+    QTimeEvt_armX(&te, 1U, 0U);
+    fill();
+    TICK_N(0U, 1U);
+    VERIFY(nDropped + 1U == QTimeEvt_getNDropped(0U));
+    VERIFY(0U == QTimeEvt_currCtr(&te)); // disarmed
+    flush();
+    TICK_N(0U, 1U);
+    VERIFY(0U == nQueued());
+}
+
+TEST("retry policy retries a periodic time event on the next tick") {
+    uint32_t const nRetried = QTimeEvt_getNRetried(0U);
+    QTimeEvt_setPolicy(&te, QTIMEEVT_POLICY_RETRY);
+    QTimeEvt_armX(&te, 3U, 10U);
+    fill();
+    TICK_N(0U, 3U);
+    VERIFY(nRetried + 1U == QTimeEvt_getNRetried(0U));
+    VERIFY(1U == QTimeEvt_currCtr(&te));
+    TICK_N(0U, 1U); // the queue is still full
+    VERIFY(nRetried + 2U == QTimeEvt_getNRetried(0U));
+    flush();
+    TICK_N(0U, 1U);
+    VERIFY(1U == nQueued());
+    VERIFY(10U == QTimeEvt_currCtr(&te));
+}
+
+TEST("retry policy retries a one-shot time event on the next tick") {
+    uint32_t const nRetried = QTimeEvt_getNRetried(0U);
+    QTimeEvt_setPolicy(&te, QTIMEEVT_POLICY_RETRY);
+    QTimeEvt_armX(&te, 2U, 0U);
+    fill();
+    TICK_N(0U, 2U);
+    VERIFY(nRetried + 1U == QTimeEvt_getNRetried(0U));
+    VERIFY(1U == QTimeEvt_currCtr(&te));
+    flush();
+    TICK_N(0U, 1U);
+    VERIFY(1U == nQueued());
+    VERIFY(0U == QTimeEvt_currCtr(&te)); // disarmed
+}
+
+TEST("re-arming a retried one-shot time event replaces the retry") {
+    uint32_t const nDropped = QTimeEvt_getNDropped(0U);
+    QTimeEvt_setPolicy(&te, QTIMEEVT_POLICY_RETRY);
+    QTimeEvt_armX(&te, 1U, 0U);
+    fill();
+    TICK_N(0U, 1U); // retried
+    flush();
+    fill();
+    VERIFY(QTimeEvt_rearm(&te, 5U)); // the retry keeps it armed
+    TICK_N(0U, 1U);
+    VERIFY(nDropped == QTimeEvt_getNDropped(0U));
+    VERIFY(4U == QTimeEvt_currCtr(&te)); // the re-armed expiry is kept
+}
+#endif // def QTIMEEVT_POST_POLICY
+
+#ifdef QTIMEEVT_SHARDS
+TEST("time event is armed and disarmed under the lock of its shard") {
+    uint32_t const nLocks = QF_shardLockCtr[1];
+    QTimeEvt_armX(&te, 5U, 0U); // ao.prio == 1 (shard 1)
+    VERIFY(nLocks + 1U == QF_shardLockCtr[1]);
+    VERIFY(QTimeEvt_disarm(&te));
+    VERIFY(nLocks + 2U == QF_shardLockCtr[1]);
+    VERIFY(shardsUnlocked());
+}
+
+TEST("time events in different shards expire at the same tick") {
+    static QTimeEvt te2;
+    QTimeEvt_ctorX(&te2, &ao2, TIMEOUT_SIG, 0U);
+    uint32_t const nLocks = QF_shardLockCtr[2];
+    QTimeEvt_armX(&te,  3U, 0U);
+    QTimeEvt_armX(&te2, 3U, 0U); // ao2.prio == 2 (shard 2)
+    VERIFY(nLocks + 1U == QF_shardLockCtr[2]);
+    TICK_N(0U, 2U);
+    VERIFY(0U == nQueued());
+    TICK_N(0U, 1U);
+    VERIFY(1U == nQueued());
+    VERIFY(&te2.super == QActive_get_(&ao2));
+    VERIFY(0U == QTimeEvt_currCtr(&te2)); // disarmed
+    VERIFY(QTimeEvt_noActive(0U));
+    VERIFY(shardsUnlocked());
+}
+#endif // def QTIMEEVT_SHARDS
+
+TEST("catch-up by zero ticks (expected assertion)") {
+    ET_expect_assert("qf_time", 100);
+    TICK_N(0U, 0U);
+}
+
+} // TEST_GROUP()
+
+//==========================================================================
+static QState AO_initial(QActive * const me, void const * const par) {
+    (void)par;
+    return Q_TRAN(&AO_active);
+}
+//..........................................................................
+static QState AO_active(QActive * const me, QEvt const * const e) {
+    (void)e;
+    return Q_SUPER(&QHsm_top);
+}
+
+// =========================================================================
+// dependencies for the CUT ...
+
+//..........................................................................
+void QF_poolInit(void * const poolSto, uint_fast32_t const poolSize,
+    uint_fast16_t const evtSize)
+{
+    (void)poolSto;
+    (void)poolSize;
+    (void)evtSize;
+}
+//..........................................................................
+uint_fast16_t QF_poolGetMaxBlockSize(void) {
+    return 0U;
+}
+//..........................................................................
+void QActive_publish_(QEvt const * const e,
+                      void const * const sender, uint_fast8_t const qs_id)
+{
+    (void)e;
+    (void)sender;
+    (void)qs_id;
+}
+//..........................................................................
+QEvt *QF_newX_(uint_fast16_t const evtSize,
+    uint_fast16_t const margin, enum_t const sig)
+{
+    (void)evtSize;
+    (void)margin;
+    (void)sig;
+
+    return (QEvt *)0;
+}
+//..........................................................................
+//! @static @public @memberof QF
+void QF_gc(QEvt const * const e) {
+    (void)e;
+}
+
+//..........................................................................
+Q_NORETURN Q_onError(char const * const module, int_t const location) {
+    VERIFY_ASSERT(module, location);
+    for (;;) { // explicitly make it "noreturn"
+    }
+}
+
+//--------------------------------------------------------------------------
+#ifdef Q_SPY
+
+void QS_onCleanup(void) {
+}
+//..........................................................................
+void QS_onReset(void) {
+}
+//..........................................................................
+void QS_onFlush(void) {
+}
+//..........................................................................
+QSTimeCtr QS_onGetTime(void) {
+    return (QSTimeCtr)0U;
+}
+//..........................................................................
+void QS_onCommand(uint8_t cmdId, uint32_t param1,
+    uint32_t param2, uint32_t param3)
+{
+    (void)cmdId;
+    (void)param1;
+    (void)param2;
+    (void)param3;
+}
+
+#endif // Q_SPY
@@ -0,0 +1,278 @@
+#include <string.h>   // for strncmp(), memcmp()
+
+#include "et.h"       // Embedded Test (ET)
+
+// includes for the CUT...
+#include "qp_port.h"      // QP port
+#include "qsafe.h"        // QP Functional Safety (FuSa) System
+#ifdef Q_SPY // software tracing enabled?
+#include "qs_port.h"      // QS/C port from the port directory
+#include "qs_pkg.h"       // QS package-scope interface (QS framing)
+#else
+#include "qs_dummy.h"     // QS/C dummy (inactive) interface
+#endif
+
+enum { N_TYPES = 10 };   // # user record types dropped in the tests
+
+static uint8_t qsBuf[512];       // buffer for QS-TX channel
+static char    str[260];         // string longer than QS_REC_MAX
+static uint8_t blk[200];         // memory block longer than QS_REC_MAX
+
+// one record read from the QS buffer (without the framing)
+static struct {
+    uint8_t data[512];  // seq, rec, and the data (without the checksum)
+    uint16_t len;       // # bytes in data[]
+    uint16_t raw;       // # bytes taken by the record in the QS buffer
+} rec;
+
+// read the next record from the QS buffer, false if there is none
+static bool readRec(void) {
+    rec.len = 0U;
+    rec.raw = 0U;
+#ifndef QS_FAST_FRAMING
+    bool esc = false;
+    for (uint16_t b = QS_getByte(); b != QS_EOD; b = QS_getByte()) {
+        ++rec.raw;
+        if (b == QS_FRAME) {
+            --rec.len; // drop the checksum
+            return true;
+        }
+        else if (b == QS_ESC) {
+            esc = true;
+        }
+        else {
+            rec.data[rec.len] = esc ? (uint8_t)(b ^ QS_ESC_XOR) : (uint8_t)b;
+            ++rec.len;
+            esc = false;
+        }
+    }
+    return false;
+#else
+    uint16_t const sync = QS_getByte();
+    if (sync == QS_EOD) {
+        return false;
+    }
+    VERIFY(QS_FAST_SYNC == sync);
+    uint16_t const lo = QS_getByte();
+    uint16_t const len = (uint16_t)(lo | (QS_getByte() << 8U));
+    for (uint16_t i = 0U; i < len; ++i) {
+        rec.data[i] = (uint8_t)QS_getByte();
+    }
+    rec.len = len;
+    rec.raw = (uint16_t)(len + 3U);
+    #ifdef QS_FAST_CRC
+    rec.len -= 2U; // drop the CRC
+    #endif
+    return true;
+#endif
+}
+
+// read out (and discard) all data in the QS buffer
+static void drain(void) {
+    while (readRec()) {
+    }
+}
+
+// produce a user record 'r_' with 'n_' 32-bit numbers
+#define USER_REC(r_, n_)                     \
+    QS_BEGIN_ID((r_), 0U)                    \
+        for (uint_fast8_t i_ = 0U; i_ < (n_); ++i_) { \
+            QS_U32(0, 0x7E7D7E7DU);          \
+        }                                    \
+    QS_END()
+
+void setup(void) {
+}
+
+void teardown(void) {
+}
+
+// test group --------------------------------------------------------------
+TEST_GROUP("QS/overflow") {
+
+QS_initBuf(qsBuf, sizeof(qsBuf));
+QS_GLB_FILTER(QS_ALL_RECORDS);
+for (uint_fast16_t i = 0U; i < sizeof(str) - 1U; ++i) {
+    str[i] = (char)('A' + (i % 26U));
+}
+for (uint_fast16_t i = 0U; i < sizeof(blk); ++i) {
+    blk[i] = (uint8_t)(0x7DU + (i & 1U)); // bytes that need escaping
+}
+drain();
+
+TEST("QS_STR longer than QS_REC_MAX is truncated") {
+    QSCtr const tail = QS_priv_.tail;
+    for (uint_fast8_t n = 0U; n < 2U; ++n) {
+        QS_BEGIN_ID(QS_USER, 0U)
+            QS_STR(str);
+        QS_END()
+    }
+    VERIFY(tail == QS_priv_.tail); // no old data overwritten
+    for (uint_fast8_t n = 0U; n < 2U; ++n) {
+        VERIFY(readRec());
+        VERIFY(rec.raw <= QS_REC_MAX);
+        VERIFY(QS_USER == rec.data[1]);
+        // seq, rec, time stamp, format, and the zero-terminated string
+        char const *s = (char const *)&rec.data[2U + QS_TIME_SIZE + 1U];
+        VERIFY('\0' == rec.data[rec.len - 1U]);
+        VERIFY(0 == strncmp(s, str, strlen(s)));
+    }
+    VERIFY(false == readRec());
+}
+
+TEST("QS_MEM longer than QS_REC_MAX is truncated") {
+    QS_BEGIN_ID(QS_USER, 0U)
+        QS_MEM(blk, sizeof(blk));
+    QS_END()
+    VERIFY(readRec());
+    VERIFY(rec.raw <= QS_REC_MAX);
+    // seq, rec, time stamp, format, size, and the bytes of the block
+    uint8_t const size = rec.data[2U + QS_TIME_SIZE + 1U];
+    VERIFY((0U < size) && (size < sizeof(blk)));
+    VERIFY(rec.len == 2U + QS_TIME_SIZE + 2U + size);
+    VERIFY(0 == memcmp(&rec.data[2U + QS_TIME_SIZE + 2U], blk, size));
+}
+
+TEST("full buffer drops the newest records, never the oldest data") {
+    QSCtr const tail = QS_priv_.tail;
+    for (uint_fast8_t n = 0U; n < 100U; ++n) {
+        USER_REC(QS_USER + (n % N_TYPES), 5U);
+        VERIFY(QS_priv_.used <= QS_priv_.end);
+    }
+    VERIFY(tail == QS_priv_.tail); // no old data overwritten
+
+    // no room for the QS_OVERFLOW report yet
+    QSCtr const used = QS_priv_.used;
+    QS_OVERFLOW_REPORT();
+    VERIFY(used == QS_priv_.used);
+
+    // the records in the buffer are complete and without sequence gaps
+    VERIFY(readRec());
+    uint8_t seq = rec.data[0];
+    while (readRec()) {
+        ++seq;
+        VERIFY(seq == rec.data[0]);
+        VERIFY(rec.raw <= QS_REC_MAX);
+    }
+}
+
+TEST("QS_OVERFLOW report is split into records of at most QS_REC_MAX") {
+    QS_OVERFLOW_REPORT();
+    uint_fast8_t nRec = 0U;
+    uint_fast8_t nPairs = 0U;
+    while (readRec()) {
+        VERIFY(QS_OVERFLOW == rec.data[1]);
+        VERIFY(rec.raw <= QS_REC_MAX);
+        VERIFY(QS_OVERFLOW_POLICY == rec.data[2U + QS_TIME_SIZE]);
+        // seq, rec, time stamp, policy, # overrun bytes, and the pairs
+        uint16_t const hdr = 2U + QS_TIME_SIZE + 1U + 4U;
+        VERIFY(0U == ((rec.len - hdr) % 5U));
+        VERIFY(0U == (rec.data[hdr - 4U] | rec.data[hdr - 3U]
+                      | rec.data[hdr - 2U] | rec.data[hdr - 1U]));
+        for (uint16_t i = hdr; i < rec.len; i += 5U) {
+            VERIFY((QS_USER <= rec.data[i])
+                   && (rec.data[i] < QS_USER + N_TYPES));
+            ++nPairs;
+        }
+        ++nRec;
+    }
+    VERIFY(N_TYPES == nPairs);
+    VERIFY(1U < nRec);
+
+    // nothing new to report
+    QS_OVERFLOW_REPORT();
+    VERIFY(false == readRec());
+}
+
+TEST("record longer than QS_REC_MAX (expected assertion)") {
+    ET_expect_assert("qs", 110);
+    USER_REC(QS_USER, 20U);
+}
+
+} // TEST_GROUP()
+
+// =========================================================================
+// dependencies for the CUT ...
+
+//..........................................................................
+void QF_poolInit(void * const poolSto, uint_fast32_t const poolSize,
+    uint_fast16_t const evtSize)
+{
+    (void)poolSto;
+    (void)poolSize;
+    (void)evtSize;
+}
+//..........................................................................
+uint_fast16_t QF_poolGetMaxBlockSize(void) {
+    return 0U;
+}
+//..........................................................................
+void QActive_publish_(QEvt const * const e,
+                      void const * const sender, uint_fast8_t const qs_id)
+{
+    (void)e;
+    (void)sender;
+    (void)qs_id;
+}
+//..........................................................................
+void QTimeEvt_tick_(uint_fast8_t const tickRate, void const * const sender) {
+    (void)tickRate;
+    (void)sender;
+}
+//..........................................................................
+void QTimeEvt_tickN_(uint_fast8_t const tickRate,
+    QTimeEvtCtr const nTicks, void const * const sender)
+{
+    (void)tickRate;
+    (void)nTicks;
+    (void)sender;
+}
+//..........................................................................
+QEvt *QF_newX_(uint_fast16_t const evtSize,
+    uint_fast16_t const margin, enum_t const sig)
+{
+    (void)evtSize;
+    (void)margin;
+    (void)sig;
+
+    return (QEvt *)0;
+}
+//..........................................................................
+//! @static @public @memberof QF
+void QF_gc(QEvt const * const e) {
+    (void)e;
+}
+
+//..........................................................................
+Q_NORETURN Q_onError(char const * const module, int_t const location) {
+    VERIFY_ASSERT(module, location);
+    for (;;) { // explicitly make it "noreturn"
+    }
+}
+
+//--------------------------------------------------------------------------
+#ifdef Q_SPY
+
+void QS_onCleanup(void) {
+}
+//..........................................................................
+void QS_onReset(void) {
+}
+//..........................................................................
+void QS_onFlush(void) {
+}
+//..........................................................................
+QSTimeCtr QS_onGetTime(void) {
+    return (QSTimeCtr)0U;
+}
+//..........................................................................
+void QS_onCommand(uint8_t cmdId, uint32_t param1,
+    uint32_t param2, uint32_t param3)
+{
+    (void)cmdId;
+    (void)param1;
+    (void)param2;
+    (void)param3;
+}
+
+#endif // Q_SPY
@@ -87,6 +87,14 @@ void QTimeEvt_tick_(uint_fast8_t const tickRate, void const * const sender) {
     (void)sender;
 }
 //..........................................................................
+void QTimeEvt_tickN_(uint_fast8_t const tickRate,
+    QTimeEvtCtr const nTicks, void const * const sender)
+{
+    (void)tickRate;
+    (void)nTicks;
+    (void)sender;
+}
+//..........................................................................
 QEvt *QF_newX_(uint_fast16_t const evtSize,
     uint_fast16_t const margin, enum_t const sig)
 {
@@ -101,9 +109,6 @@ QEvt *QF_newX_(uint_fast16_t const evtSize,
 void QF_gc(QEvt const * const e) {
     (void)e;
 }
-//..........................................................................
-//! @static @private @memberof QF
-QActive *QActive_registry_[QF_MAX_ACTIVE + 1U];
 
 //..........................................................................
 Q_NORETURN Q_onError(char const * const module, int_t const location) {
@@ -0,0 +1,186 @@
+#include "et.h"       // Embedded Test (ET)
+
+// includes for the CUT...
+#include "qp_port.h"      // QP port
+#include "qsafe.h"        // QP Functional Safety (FuSa) System
+#ifdef Q_SPY // software tracing enabled?
+#include "qs_port.h"      // QS/C port from the port directory
+#include "qs_pkg.h"       // QS package-scope interface (QS framing)
+#else
+#include "qs_dummy.h"     // QS/C dummy (inactive) interface
+#endif
+
+static uint8_t qsBuf[1024];      // buffer for QS-TX channel
+
+// read out all data in the QS buffer and return the # records in it
+static uint_fast16_t drain(void) {
+    uint_fast16_t n = 0U;
+    for (uint16_t b = QS_getByte(); b != QS_EOD; b = QS_getByte()) {
+        if (b == QS_FRAME) {
+            ++n;
+        }
+    }
+    return n;
+}
+
+// produce 'n_' user records 'r_' with the QS-ID 'id_'
+#define USER_REC(r_, id_, n_)                       \
+    for (uint_fast8_t i_ = 0U; i_ < (n_); ++i_) {   \
+        QS_BEGIN_ID((r_), (id_))                    \
+            QS_U8(0, i_);                           \
+        QS_END()                                    \
+    }
+
+void setup(void) {
+}
+
+void teardown(void) {
+    (void)drain();
+}
+
+// test group --------------------------------------------------------------
+TEST_GROUP("QS/sampling") {
+
+QS_initBuf(qsBuf, sizeof(qsBuf));
+QS_GLB_FILTER(QS_ALL_RECORDS);
+QS_LOC_FILTER(QS_ALL_IDS);
+(void)drain();
+
+TEST("records without limits are not sampled") {
+    USER_REC(QS_USER, 1U, 10U);
+    VERIFY(10U == drain());
+}
+
+TEST("sampling passes 1 in nth records") {
+    VERIFY(QS_SMP_FILTER(QS_USER, 3U, 0U, 0U));
+    USER_REC(QS_USER, 1U, 9U);
+    VERIFY(3U == drain());
+    USER_REC(QS_USER + 1U, 1U, 9U); // other record types not affected
+    VERIFY(9U == drain());
+}
+
+TEST("limits removed with all parameters 0") {
+    VERIFY(QS_SMP_FILTER(QS_USER, 0U, 0U, 0U));
+    USER_REC(QS_USER, 1U, 9U);
+    VERIFY(9U == drain());
+}
+
+TEST("token bucket limits the burst of each QS-ID") {
+    VERIFY(QS_SMP_FILTER(QS_USER + 1U, 0U, 2U, 4U));
+    USER_REC(QS_USER + 1U, 1U, 10U);
+    VERIFY(4U == drain());
+    USER_REC(QS_USER + 1U, 2U, 10U); // separate bucket for QS-ID 2
+    VERIFY(4U == drain());
+    USER_REC(QS_USER + 1U, 1U, 10U); // bucket of QS-ID 1 empty
+    VERIFY(0U == drain());
+}
+
+TEST("token bucket refilled by rate up to the burst") {
+    QS_SMP_TICK();
+    USER_REC(QS_USER + 1U, 1U, 10U);
+    VERIFY(2U == drain());
+    QS_SMP_TICK();
+    QS_SMP_TICK();
+    QS_SMP_TICK();
+    USER_REC(QS_USER + 1U, 1U, 10U);
+    VERIFY(4U == drain());
+}
+
+TEST("no free slot for more record types with limits") {
+    VERIFY(QS_SMP_FILTER(QS_USER, 2U, 0U, 0U));
+    VERIFY(false == QS_SMP_FILTER(QS_USER + 2U, 2U, 0U, 0U));
+    USER_REC(QS_USER + 2U, 1U, 4U);
+    VERIFY(4U == drain());
+    VERIFY(QS_SMP_FILTER(QS_USER + 1U, 0U, 0U, 0U)); // free one slot
+    VERIFY(QS_SMP_FILTER(QS_USER + 2U, 2U, 0U, 0U));
+    USER_REC(QS_USER + 2U, 1U, 4U);
+    VERIFY(2U == drain());
+}
+
+} // TEST_GROUP()
+
+// =========================================================================
+// dependencies for the CUT ...
+
+//..........................................................................
+void QF_poolInit(void * const poolSto, uint_fast32_t const poolSize,
+    uint_fast16_t const evtSize)
+{
+    (void)poolSto;
+    (void)poolSize;
+    (void)evtSize;
+}
+//..........................................................................
+uint_fast16_t QF_poolGetMaxBlockSize(void) {
+    return 0U;
+}
+//..........................................................................
+void QActive_publish_(QEvt const * const e,
+                      void const * const sender, uint_fast8_t const qs_id)
+{
+    (void)e;
+    (void)sender;
+    (void)qs_id;
+}
+//..........................................................................
+void QTimeEvt_tick_(uint_fast8_t const tickRate, void const * const sender) {
+    (void)tickRate;
+    (void)sender;
+}
+//..........................................................................
+void QTimeEvt_tickN_(uint_fast8_t const tickRate,
+    QTimeEvtCtr const nTicks, void const * const sender)
+{
+    (void)tickRate;
+    (void)nTicks;
+    (void)sender;
+}
+//..........................................................................
+QEvt *QF_newX_(uint_fast16_t const evtSize,
+    uint_fast16_t const margin, enum_t const sig)
+{
+    (void)evtSize;
+    (void)margin;
+    (void)sig;
+
+    return (QEvt *)0;
+}
+//..........................................................................
+//! @static @public @memberof QF
+void QF_gc(QEvt const * const e) {
+    (void)e;
+}
+
+//..........................................................................
+Q_NORETURN Q_onError(char const * const module, int_t const location) {
+    VERIFY_ASSERT(module, location);
+    for (;;) { // explicitly make it "noreturn"
+    }
+}
+
+//--------------------------------------------------------------------------
+#ifdef Q_SPY
+
+void QS_onCleanup(void) {
+}
+//..........................................................................
+void QS_onReset(void) {
+}
+//..........................................................................
+void QS_onFlush(void) {
+}
+//..........................................................................
+QSTimeCtr QS_onGetTime(void) {
+    return (QSTimeCtr)0U;
+}
+//..........................................................................
+void QS_onCommand(uint8_t cmdId, uint32_t param1,
+    uint32_t param2, uint32_t param3)
+{
+    (void)cmdId;
+    (void)param1;
+    (void)param2;
+    (void)param3;
+}
+
+#endif // Q_SPY